@@ -0,0 +1,422 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Json.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace FireboltMock {
+
+    class Json::Parser {
+    public:
+        explicit Parser(const std::string& text)
+            : _text(text)
+            , _position(0)
+        {
+        }
+
+        bool Document(Json& value)
+        {
+            return Value(value, 0) && (SkipSpace(), _position == _text.size());
+        }
+
+    private:
+        static constexpr uint32_t MaxDepth = 64;
+
+        void SkipSpace()
+        {
+            while ((_position < _text.size()) && ((_text[_position] == ' ') || (_text[_position] == '\t') || (_text[_position] == '\n') || (_text[_position] == '\r'))) {
+                ++_position;
+            }
+        }
+        bool Literal(const char* literal)
+        {
+            const size_t length = strlen(literal);
+            if (_text.compare(_position, length, literal) == 0) {
+                _position += length;
+                return true;
+            }
+            return false;
+        }
+        bool Value(Json& value, const uint32_t depth)
+        {
+            SkipSpace();
+            if ((_position >= _text.size()) || (depth > MaxDepth)) {
+                return false;
+            }
+            switch (_text[_position]) {
+            case '{':
+                return ObjectValue(value, depth);
+            case '[':
+                return ArrayValue(value, depth);
+            case '"':
+                value._type = Type::String;
+                return StringValue(value._text);
+            case 't':
+                value = Json(true);
+                return Literal("true");
+            case 'f':
+                value = Json(false);
+                return Literal("false");
+            case 'n':
+                value = Json();
+                return Literal("null");
+            default:
+                return NumberValue(value);
+            }
+        }
+        bool ObjectValue(Json& value, const uint32_t depth)
+        {
+            value = Json::Object();
+            ++_position;
+            SkipSpace();
+            if ((_position < _text.size()) && (_text[_position] == '}')) {
+                ++_position;
+                return true;
+            }
+            while (_position < _text.size()) {
+                std::string name;
+                Json member;
+                SkipSpace();
+                if ((_position >= _text.size()) || (_text[_position] != '"') || (StringValue(name) == false)) {
+                    return false;
+                }
+                SkipSpace();
+                if ((_position >= _text.size()) || (_text[_position++] != ':') || (Value(member, depth + 1) == false)) {
+                    return false;
+                }
+                value._members.emplace_back(std::move(name), std::move(member));
+                SkipSpace();
+                if (_position >= _text.size()) {
+                    return false;
+                }
+                const char next = _text[_position++];
+                if (next == '}') {
+                    return true;
+                }
+                if (next != ',') {
+                    return false;
+                }
+            }
+            return false;
+        }
+        bool ArrayValue(Json& value, const uint32_t depth)
+        {
+            value = Json::Array();
+            ++_position;
+            SkipSpace();
+            if ((_position < _text.size()) && (_text[_position] == ']')) {
+                ++_position;
+                return true;
+            }
+            while (_position < _text.size()) {
+                Json element;
+                if (Value(element, depth + 1) == false) {
+                    return false;
+                }
+                value._elements.push_back(std::move(element));
+                SkipSpace();
+                if (_position >= _text.size()) {
+                    return false;
+                }
+                const char next = _text[_position++];
+                if (next == ']') {
+                    return true;
+                }
+                if (next != ',') {
+                    return false;
+                }
+            }
+            return false;
+        }
+        static void AppendUtf8(std::string& result, const uint32_t code)
+        {
+            if (code < 0x80) {
+                result += static_cast<char>(code);
+            } else if (code < 0x800) {
+                result += static_cast<char>(0xC0 | (code >> 6));
+                result += static_cast<char>(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                result += static_cast<char>(0xE0 | (code >> 12));
+                result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+                result += static_cast<char>(0xF0 | (code >> 18));
+                result += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+        bool Hex4(uint32_t& code)
+        {
+            if ((_position + 4) > _text.size()) {
+                return false;
+            }
+            code = 0;
+            for (uint32_t index = 0; index < 4; ++index) {
+                const char digit = _text[_position++];
+                code <<= 4;
+                if ((digit >= '0') && (digit <= '9')) {
+                    code |= (digit - '0');
+                } else if ((digit >= 'a') && (digit <= 'f')) {
+                    code |= (digit - 'a' + 10);
+                } else if ((digit >= 'A') && (digit <= 'F')) {
+                    code |= (digit - 'A' + 10);
+                } else {
+                    return false;
+                }
+            }
+            return true;
+        }
+        bool StringValue(std::string& result)
+        {
+            ++_position;
+            while (_position < _text.size()) {
+                const char character = _text[_position++];
+                if (character == '"') {
+                    return true;
+                }
+                if (character != '\\') {
+                    result += character;
+                    continue;
+                }
+                if (_position >= _text.size()) {
+                    return false;
+                }
+                const char escaped = _text[_position++];
+                switch (escaped) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': {
+                    uint32_t code;
+                    if (Hex4(code) == false) {
+                        return false;
+                    }
+                    if ((code >= 0xD800) && (code < 0xDC00) && Literal("\\u")) {
+                        uint32_t low;
+                        if ((Hex4(low) == false) || (low < 0xDC00) || (low > 0xDFFF)) {
+                            return false;
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    AppendUtf8(result, code);
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            return false;
+        }
+        bool NumberValue(Json& value)
+        {
+            const size_t start = _position;
+            if ((_position < _text.size()) && (_text[_position] == '-')) {
+                ++_position;
+            }
+            bool digits = false;
+            while ((_position < _text.size()) && (_text[_position] != '\0') && (strchr("0123456789.eE+-", _text[_position]) != nullptr)) {
+                digits = digits || ((_text[_position] >= '0') && (_text[_position] <= '9'));
+                ++_position;
+            }
+            if (digits == false) {
+                return false;
+            }
+            value = Json();
+            value._type = Type::Number;
+            value._text = _text.substr(start, _position - start);
+            char* end = nullptr;
+            strtod(value._text.c_str(), &end);
+            return (end != nullptr) && (*end == '\0');
+        }
+
+    private:
+        const std::string& _text;
+        size_t _position;
+    };
+
+    /* static */ Json Json::Number(const double value)
+    {
+        Json result;
+        result._type = Type::Number;
+        char text[32];
+        if ((std::floor(value) == value) && (std::fabs(value) < 1e15)) {
+            snprintf(text, sizeof(text), "%.0f", value);
+        } else {
+            snprintf(text, sizeof(text), "%.17g", value);
+        }
+        result._text = text;
+        return result;
+    }
+    /* static */ Json Json::Array()
+    {
+        Json result;
+        result._type = Type::Array;
+        return result;
+    }
+    /* static */ Json Json::Object()
+    {
+        Json result;
+        result._type = Type::Object;
+        return result;
+    }
+
+    /* static */ bool Json::Parse(const std::string& text, Json& value)
+    {
+        Parser parser(text);
+        if (parser.Document(value) == false) {
+            value = Json();
+            return false;
+        }
+        return true;
+    }
+
+    double Json::Double() const
+    {
+        return (_type == Type::Number) ? strtod(_text.c_str(), nullptr) : 0;
+    }
+
+    const Json* Json::Find(const std::string& name) const
+    {
+        for (const Member& member : _members) {
+            if (member.first == name) {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+    const Json& Json::operator[](const std::string& name) const
+    {
+        static const Json null;
+        const Json* member = Find(name);
+        return (member != nullptr) ? *member : null;
+    }
+    void Json::Set(const std::string& name, const Json& value)
+    {
+        for (Member& member : _members) {
+            if (member.first == name) {
+                member.second = value;
+                return;
+            }
+        }
+        _members.emplace_back(name, value);
+    }
+
+    bool Json::operator==(const Json& other) const
+    {
+        if (_type != other._type) {
+            return false;
+        }
+        switch (_type) {
+        case Type::Null:
+            return true;
+        case Type::Boolean:
+            return _boolean == other._boolean;
+        case Type::Number:
+            return Double() == other.Double();
+        case Type::String:
+            return _text == other._text;
+        case Type::Array:
+            return _elements == other._elements;
+        case Type::Object:
+            if (_members.size() != other._members.size()) {
+                return false;
+            }
+            for (const Member& member : _members) {
+                const Json* match = other.Find(member.first);
+                if ((match == nullptr) || (*match != member.second)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    static void AppendString(std::string& result, const std::string& text)
+    {
+        result += '"';
+        for (const char character : text) {
+            switch (character) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\b': result += "\\b"; break;
+            case '\f': result += "\\f"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+                    result += escaped;
+                } else {
+                    result += character;
+                }
+            }
+        }
+        result += '"';
+    }
+
+    std::string Json::ToString() const
+    {
+        std::string result;
+        switch (_type) {
+        case Type::Null:
+            result = "null";
+            break;
+        case Type::Boolean:
+            result = _boolean ? "true" : "false";
+            break;
+        case Type::Number:
+            result = _text;
+            break;
+        case Type::String:
+            AppendString(result, _text);
+            break;
+        case Type::Array:
+            result += '[';
+            for (size_t index = 0; index < _elements.size(); ++index) {
+                result += (index > 0) ? "," : "";
+                result += _elements[index].ToString();
+            }
+            result += ']';
+            break;
+        case Type::Object:
+            result += '{';
+            for (size_t index = 0; index < _members.size(); ++index) {
+                result += (index > 0) ? "," : "";
+                AppendString(result, _members[index].first);
+                result += ':';
+                result += _members[index].second.ToString();
+            }
+            result += '}';
+            break;
+        }
+        return result;
+    }
+
+} // namespace FireboltMock
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace FireboltMock {
+
+    // Just enough JSON for the mock: parses the specification and JSON-RPC messages and writes
+    // them back. Numbers keep their source text, so example payloads are echoed unchanged.
+    class Json {
+    public:
+        enum class Type : uint8_t {
+            Null,
+            Boolean,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        using Member = std::pair<std::string, Json>;
+
+        Json()
+            : _type(Type::Null)
+            , _boolean(false)
+        {
+        }
+        Json(const bool value)
+            : _type(Type::Boolean)
+            , _boolean(value)
+        {
+        }
+        Json(const char* value)
+            : _type(Type::String)
+            , _boolean(false)
+            , _text(value)
+        {
+        }
+        Json(const std::string& value)
+            : _type(Type::String)
+            , _boolean(false)
+            , _text(value)
+        {
+        }
+        static Json Number(const double value);
+        static Json Array();
+        static Json Object();
+
+        // Returns false, and leaves value Null, on malformed input
+        static bool Parse(const std::string& text, Json& value);
+        std::string ToString() const;
+
+        Type GetType() const { return _type; }
+        bool IsNull() const { return _type == Type::Null; }
+        bool IsObject() const { return _type == Type::Object; }
+        bool IsArray() const { return _type == Type::Array; }
+        bool IsString() const { return _type == Type::String; }
+
+        bool Boolean() const { return _boolean; }
+        double Double() const;
+        const std::string& String() const { return _text; }
+
+        // Arrays
+        const std::vector<Json>& Elements() const { return _elements; }
+        void Add(const Json& element) { _elements.push_back(element); }
+
+        // Objects, members keep their order
+        const std::vector<Member>& Members() const { return _members; }
+        const Json* Find(const std::string& name) const;
+        const Json& operator[](const std::string& name) const;
+        void Set(const std::string& name, const Json& value);
+
+        bool operator==(const Json& other) const;
+        bool operator!=(const Json& other) const { return !(*this == other); }
+
+    private:
+        class Parser;
+
+        Type _type;
+        bool _boolean;
+        std::string _text; // string value or number source text
+        std::vector<Json> _elements;
+        std::vector<Member> _members;
+    };
+
+} // namespace FireboltMock
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Server.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <getopt.h>
+#include <unistd.h>
+
+#ifndef FIREBOLT_MOCK_SPEC_PATH
+#define FIREBOLT_MOCK_SPEC_PATH "."
+#endif
+
+static volatile sig_atomic_t running = 1;
+
+static void OnSignal(int)
+{
+    running = 0;
+}
+
+static void Usage(const char* name)
+{
+    printf("%s [-p port] [-s openrpc dir] [-l latency ms] [-j jitter ms] [-r events/s] [-n]\n", name);
+    printf("  -p  port to listen on, default 9998\n");
+    printf("  -s  directory with the OpenRPC documents, default %s\n", FIREBOLT_MOCK_SPEC_PATH);
+    printf("  -l  latency added to every response\n");
+    printf("  -j  random jitter on top of the latency, 0..N ms\n");
+    printf("  -r  events per second for every subscribed event\n");
+    printf("  -n  send events as JSON-RPC notifications\n");
+}
+
+int main(int argc, char* argv[])
+{
+    FireboltMock::Server::Options options;
+    std::string specPath = FIREBOLT_MOCK_SPEC_PATH;
+
+    int option;
+    while ((option = getopt(argc, argv, "p:s:l:j:r:nh")) != -1) {
+        switch (option) {
+        case 'p':
+            options.port = static_cast<uint16_t>(atoi(optarg));
+            break;
+        case 's':
+            specPath = optarg;
+            break;
+        case 'l':
+            options.latencyMs = static_cast<uint32_t>(atoi(optarg));
+            break;
+        case 'j':
+            options.jitterMs = static_cast<uint32_t>(atoi(optarg));
+            break;
+        case 'r':
+            options.eventRate = atof(optarg);
+            break;
+        case 'n':
+            options.notificationEvents = true;
+            break;
+        default:
+            Usage(argv[0]);
+            return (option == 'h') ? 0 : 1;
+        }
+    }
+
+    FireboltMock::Specification specification;
+    if (specification.Load(specPath) == false) {
+        fprintf(stderr, "No OpenRPC documents loaded from %s\n", specPath.c_str());
+        return 1;
+    }
+    FireboltMock::Server server(specification, options);
+    if (server.Start() == false) {
+        fprintf(stderr, "Cannot listen on port %u\n", options.port);
+        return 1;
+    }
+    printf("Serving %zu methods on ws://127.0.0.1:%u\n", specification.Count(), server.Port());
+    fflush(stdout);
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    while (running == 1) {
+        pause();
+    }
+    server.Stop();
+
+    const FireboltMock::Server::Statistics stats = server.Stats();
+    printf("connections %llu, requests %llu, events %llu, errors %llu, received %llu bytes, sent %llu bytes\n",
+        static_cast<unsigned long long>(stats.connections), static_cast<unsigned long long>(stats.requests),
+        static_cast<unsigned long long>(stats.events), static_cast<unsigned long long>(stats.errors),
+        static_cast<unsigned long long>(stats.bytesReceived), static_cast<unsigned long long>(stats.bytesSent));
+    return 0;
+}
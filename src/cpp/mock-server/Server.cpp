@@ -0,0 +1,496 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Server.h"
+#include "WebSocket.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <netinet/in.h>
+#include <queue>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+namespace FireboltMock {
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t IdleWakeupMs = 100;
+
+    static std::string Lowercase(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](const unsigned char character) { return std::tolower(character); });
+        return text;
+    }
+
+    static std::string Response(const Json& id, const Json& result)
+    {
+        Json response = Json::Object();
+        response.Set("jsonrpc", "2.0");
+        response.Set("id", id);
+        response.Set("result", result);
+        return response.ToString();
+    }
+
+    static std::string ErrorResponse(const Json& id, const int32_t code, const char* message)
+    {
+        Json error = Json::Object();
+        error.Set("code", Json::Number(code));
+        error.Set("message", message);
+        Json response = Json::Object();
+        response.Set("jsonrpc", "2.0");
+        response.Set("id", id);
+        response.Set("error", error);
+        return response.ToString();
+    }
+
+    class Server::Connection {
+    private:
+        struct Outgoing {
+            Clock::time_point due;
+            std::string message;
+            bool operator>(const Outgoing& other) const { return due > other.due; }
+        };
+        struct Subscription {
+            std::string event; // as subscribed
+            Json id;
+            const Specification::Method* method;
+            size_t next;
+            Clock::time_point due;
+        };
+
+    public:
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+
+        Connection(Server& server, const int socket)
+            : _server(server)
+            , _fd(socket)
+            , _random(static_cast<uint32_t>(socket))
+            , _stopping(false)
+            , _done(false)
+        {
+            _reader = std::thread(&Connection::Reader, this, socket);
+            _scheduler = std::thread(&Connection::Scheduler, this);
+        }
+        ~Connection()
+        {
+            Stop();
+            _reader.join();
+            _scheduler.join();
+        }
+
+        void Stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _stopping = true;
+            }
+            _wakeup.notify_all();
+            // Not WebSocket::Close, the reader may not have taken the socket over yet
+            ::shutdown(_fd, SHUT_RDWR);
+        }
+        bool IsDone() const
+        {
+            return _done.load(std::memory_order_acquire);
+        }
+
+        std::mt19937& Random() { return _random; }
+
+        void Send(const std::string& message, const uint32_t delayMs)
+        {
+            if (delayMs == 0) {
+                _socket.Send(message);
+            } else {
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    _outgoing.push({ Clock::now() + std::chrono::milliseconds(delayMs), message });
+                }
+                _wakeup.notify_all();
+            }
+        }
+
+        // The first event is due once the listen response (sent with delayMs) is out
+        void Subscribe(const std::string& event, const Json& id, const Specification::Method& method, const uint32_t delayMs)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _subscriptions[Lowercase(event)] = { event, id, &method, 0, Clock::now() + std::chrono::milliseconds(delayMs) };
+            }
+            _wakeup.notify_all();
+        }
+        void Unsubscribe(const std::string& event)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _subscriptions.erase(Lowercase(event));
+        }
+
+        // Sends the event now if subscribed, a null payload takes the next example
+        bool Emit(const std::string& event, const Json* payload)
+        {
+            std::string message;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto entry = _subscriptions.find(Lowercase(event));
+                if (entry == _subscriptions.end()) {
+                    return false;
+                }
+                message = EventMessage(entry->second, payload);
+            }
+            _server._events.fetch_add(1, std::memory_order_relaxed);
+            return _socket.Send(message);
+        }
+
+        uint64_t BytesReceived() const { return _socket.BytesReceived(); }
+        uint64_t BytesSent() const { return _socket.BytesSent(); }
+
+    private:
+        std::string EventMessage(Subscription& subscription, const Json* payload)
+        {
+            static const Json null;
+            const std::vector<Specification::Example>& examples = subscription.method->examples;
+            if (payload == nullptr) {
+                payload = examples.empty() ? &null : &examples[subscription.next++ % examples.size()].result;
+            }
+            Json stamped;
+            if ((_server._stampEvents.load(std::memory_order_relaxed) == true) && (payload->IsObject() == true)) {
+                // Same clock as steady_clock in the receiving process, for end to end latency
+                stamped = *payload;
+                stamped.Set("sentUs", Json::Number(static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count())));
+                payload = &stamped;
+            }
+            if (_server._notificationEvents == true) {
+                Json notification = Json::Object();
+                notification.Set("jsonrpc", "2.0");
+                notification.Set("method", subscription.event);
+                notification.Set("params", *payload);
+                return notification.ToString();
+            }
+            return Response(subscription.id, *payload);
+        }
+
+        void Reader(const int socket)
+        {
+            if (_socket.Accept(socket) == true) {
+                std::string message;
+                while (_socket.Receive(message) == true) {
+                    _server.Dispatch(*this, message);
+                }
+            }
+            Stop();
+            _done.store(true, std::memory_order_release);
+        }
+
+        void Scheduler()
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            while (_stopping == false) {
+                const Clock::time_point now = Clock::now();
+                Clock::time_point wakeup = now + std::chrono::milliseconds(IdleWakeupMs);
+                std::vector<std::string> messages;
+
+                while ((_outgoing.empty() == false) && (_outgoing.top().due <= now)) {
+                    messages.push_back(_outgoing.top().message);
+                    _outgoing.pop();
+                }
+                if (_outgoing.empty() == false) {
+                    wakeup = std::min(wakeup, _outgoing.top().due);
+                }
+                for (auto& entry : _subscriptions) {
+                    Subscription& subscription = entry.second;
+                    const double rate = _server.EventRate(entry.first);
+                    if (rate <= 0) {
+                        subscription.due = std::max(subscription.due, now);
+                        continue;
+                    }
+                    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+                    if (subscription.due <= now) {
+                        messages.push_back(EventMessage(subscription, nullptr));
+                        _server._events.fetch_add(1, std::memory_order_relaxed);
+                        // Keep the rate, but do not burst to catch up after a stall
+                        subscription.due = std::max(subscription.due + interval, now);
+                    }
+                    wakeup = std::min(wakeup, subscription.due);
+                }
+
+                if (messages.empty() == false) {
+                    lock.unlock();
+                    for (const std::string& message : messages) {
+                        _socket.Send(message);
+                    }
+                    lock.lock();
+                } else {
+                    _wakeup.wait_until(lock, wakeup);
+                }
+            }
+        }
+
+    private:
+        Server& _server;
+        const int _fd;
+        WebSocket _socket;
+        std::mt19937 _random;
+
+        std::mutex _lock;
+        std::condition_variable _wakeup;
+        std::priority_queue<Outgoing, std::vector<Outgoing>, std::greater<Outgoing>> _outgoing;
+        std::map<std::string, Subscription> _subscriptions;
+        bool _stopping;
+        std::atomic<bool> _done;
+
+        std::thread _reader;
+        std::thread _scheduler;
+    };
+
+    Server::Server(const Specification& specification, const Options& options)
+        : _specification(specification)
+        , _notificationEvents(options.notificationEvents)
+        , _listener(-1)
+        , _port(options.port)
+        , _running(false)
+        , _latencyMs(options.latencyMs)
+        , _jitterMs(options.jitterMs)
+        , _eventRate(options.eventRate)
+        , _stampEvents(false)
+        , _connectionCount(0)
+        , _requests(0)
+        , _events(0)
+        , _errors(0)
+        , _bytesReceived(0)
+        , _bytesSent(0)
+    {
+    }
+    Server::~Server()
+    {
+        Stop();
+    }
+
+    bool Server::Start()
+    {
+        _listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (_listener < 0) {
+            return false;
+        }
+        const int enable = 1;
+        setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(_port);
+        socklen_t length = sizeof(address);
+        if ((::bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+            || (::listen(_listener, 16) != 0)
+            || (::getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &length) != 0)) {
+            ::close(_listener);
+            _listener = -1;
+            return false;
+        }
+        _port = ntohs(address.sin_port);
+        _running = true;
+        _acceptor = std::thread(&Server::Acceptor, this);
+        return true;
+    }
+
+    void Server::Stop()
+    {
+        if (_running.exchange(false) == true) {
+            ::shutdown(_listener, SHUT_RDWR);
+            _acceptor.join();
+            ::close(_listener);
+            _listener = -1;
+
+            std::list<std::shared_ptr<Connection>> connections;
+            {
+                std::lock_guard<std::mutex> lock(_connectionsLock);
+                connections.swap(_connections);
+            }
+            for (const std::shared_ptr<Connection>& connection : connections) {
+                _bytesReceived += connection->BytesReceived();
+                _bytesSent += connection->BytesSent();
+            }
+            // Connection destructors stop and join their threads
+        }
+    }
+
+    void Server::Acceptor()
+    {
+        while (_running == true) {
+            const int socket = ::accept(_listener, nullptr, nullptr);
+            if (socket < 0) {
+                continue;
+            }
+            std::list<std::shared_ptr<Connection>> finished;
+            std::lock_guard<std::mutex> lock(_connectionsLock);
+            for (auto entry = _connections.begin(); entry != _connections.end();) {
+                if ((*entry)->IsDone() == true) {
+                    _bytesReceived += (*entry)->BytesReceived();
+                    _bytesSent += (*entry)->BytesSent();
+                    finished.push_back(*entry);
+                    entry = _connections.erase(entry);
+                } else {
+                    ++entry;
+                }
+            }
+            _connections.push_back(std::make_shared<Connection>(*this, socket));
+            _connectionCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Server::Statistics Server::Stats() const
+    {
+        Statistics statistics = {};
+        statistics.connections = _connectionCount.load(std::memory_order_relaxed);
+        statistics.requests = _requests.load(std::memory_order_relaxed);
+        statistics.events = _events.load(std::memory_order_relaxed);
+        statistics.errors = _errors.load(std::memory_order_relaxed);
+        statistics.bytesReceived = _bytesReceived.load(std::memory_order_relaxed);
+        statistics.bytesSent = _bytesSent.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(_connectionsLock);
+        for (const std::shared_ptr<Connection>& connection : _connections) {
+            statistics.bytesReceived += connection->BytesReceived();
+            statistics.bytesSent += connection->BytesSent();
+        }
+        return statistics;
+    }
+
+    uint32_t Server::Delay(const std::string& method, std::mt19937& random) const
+    {
+        std::lock_guard<std::mutex> lock(_configLock);
+        auto entry = _methodLatency.find(Lowercase(method));
+        uint32_t delay = (entry != _methodLatency.end()) ? entry->second : _latencyMs;
+        if (_jitterMs > 0) {
+            delay += std::uniform_int_distribution<uint32_t>(0, _jitterMs)(random);
+        }
+        return delay;
+    }
+
+    double Server::EventRate(const std::string& event) const
+    {
+        std::lock_guard<std::mutex> lock(_configLock);
+        auto entry = _eventRates.find(Lowercase(event));
+        return (entry != _eventRates.end()) ? entry->second : _eventRate;
+    }
+
+    void Server::Dispatch(Connection& connection, const std::string& message)
+    {
+        _requests.fetch_add(1, std::memory_order_relaxed);
+
+        Json request;
+        if ((Json::Parse(message, request) == false) || (request.IsObject() == false)) {
+            _errors.fetch_add(1, std::memory_order_relaxed);
+            connection.Send(ErrorResponse(Json(), -32700, "Parse error"), 0);
+            return;
+        }
+        // Requests without an id are notifications and do not get a response
+        const Json* id = request.Find("id");
+        const Json requestId = (id != nullptr) ? *id : Json();
+        const std::string& name = request["method"].String();
+        const Json& params = request["params"];
+
+        std::string response;
+        if (name.compare(0, 5, "mock.") == 0) {
+            Json error;
+            const Json result = Control(name, params, error);
+            if (error.IsNull() == false) {
+                _errors.fetch_add(1, std::memory_order_relaxed);
+                response = ErrorResponse(requestId, -32602, error.String().c_str());
+            } else {
+                response = Response(requestId, result);
+            }
+        } else if (const Specification::Method* method = _specification.Find(name)) {
+            if (method->event == true) {
+                const bool listen = params["listen"].Boolean();
+                Json result = Json::Object();
+                result.Set("listening", listen);
+                result.Set("event", name);
+                const uint32_t delay = Delay(name, connection.Random());
+                if (id != nullptr) {
+                    connection.Send(Response(requestId, result), delay);
+                }
+                if (listen == true) {
+                    connection.Subscribe(name, requestId, *method, delay);
+                } else {
+                    connection.Unsubscribe(name);
+                }
+                return;
+            } else {
+                response = Response(requestId, Specification::Result(*method, params));
+            }
+        } else {
+            _errors.fetch_add(1, std::memory_order_relaxed);
+            response = ErrorResponse(requestId, -32601, "Method not found");
+        }
+
+        if (id != nullptr) {
+            connection.Send(response, Delay(name, connection.Random()));
+        }
+    }
+
+    Json Server::Control(const std::string& method, const Json& params, Json& error)
+    {
+        Json result = Json::Object();
+        if (method == "mock.setLatency") {
+            std::lock_guard<std::mutex> lock(_configLock);
+            const uint32_t latency = static_cast<uint32_t>(std::max(0.0, params["ms"].Double()));
+            if (params["method"].IsString() == true) {
+                _methodLatency[Lowercase(params["method"].String())] = latency;
+            } else {
+                _latencyMs = latency;
+                _methodLatency.clear();
+            }
+            if (params.Find("jitterMs") != nullptr) {
+                _jitterMs = static_cast<uint32_t>(std::max(0.0, params["jitterMs"].Double()));
+            }
+        } else if (method == "mock.setEventRate") {
+            std::lock_guard<std::mutex> lock(_configLock);
+            const double rate = std::max(0.0, params["perSecond"].Double());
+            if (params.Find("stamp") != nullptr) {
+                _stampEvents = params["stamp"].Boolean();
+            }
+            if (params["event"].IsString() == true) {
+                _eventRates[Lowercase(params["event"].String())] = rate;
+            } else {
+                _eventRate = rate;
+                _eventRates.clear();
+            }
+        } else if (method == "mock.emit") {
+            const Json* payload = params.Find("result");
+            uint32_t delivered = 0;
+            std::lock_guard<std::mutex> lock(_connectionsLock);
+            for (const std::shared_ptr<Connection>& connection : _connections) {
+                delivered += (connection->Emit(params["event"].String(), payload) == true) ? 1 : 0;
+            }
+            result.Set("delivered", Json::Number(delivered));
+        } else if (method == "mock.stats") {
+            const Statistics statistics = Stats();
+            result.Set("connections", Json::Number(statistics.connections));
+            result.Set("requests", Json::Number(statistics.requests));
+            result.Set("events", Json::Number(statistics.events));
+            result.Set("errors", Json::Number(statistics.errors));
+            result.Set("bytesReceived", Json::Number(statistics.bytesReceived));
+            result.Set("bytesSent", Json::Number(statistics.bytesSent));
+        } else {
+            error = Json("Unknown mock method " + method);
+        }
+        return result;
+    }
+
+} // namespace FireboltMock
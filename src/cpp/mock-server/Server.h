@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "Json.h"
+#include "Specification.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace FireboltMock {
+
+    // Firebolt JSON-RPC over WebSocket, answering from the specification examples. Every
+    // connection has a reader thread and a scheduler thread; the scheduler sends delayed
+    // responses (injected latency) and the periodic events of the subscriptions.
+    //
+    // Besides the specification methods the mock answers:
+    //   mock.setLatency   {"ms": N, "jitterMs": N, "method": "device.name"}  method is optional
+    //   mock.setEventRate {"perSecond": N, "event": "device.onNameChanged", "stamp": true}
+    //                     event is optional, stamp adds "sentUs" to object payloads
+    //   mock.emit         {"event": "device.onNameChanged", "result": ...}    result is optional
+    //   mock.stats        connections, requests, events, errors and bytes so far
+    class Server {
+    public:
+        struct Options {
+            uint16_t port = 9998; // 0 picks a free port, see Port()
+            uint32_t latencyMs = 0;
+            uint32_t jitterMs = 0;
+            double eventRate = 0; // events per second per subscription, 0 sends them on mock.emit only
+            bool notificationEvents = false; // events as JSON-RPC notifications instead of responses to the listen id
+        };
+
+        struct Statistics {
+            uint64_t connections;
+            uint64_t requests;
+            uint64_t events;
+            uint64_t errors;
+            uint64_t bytesReceived;
+            uint64_t bytesSent;
+        };
+
+    public:
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+
+        Server(const Specification& specification, const Options& options);
+        ~Server();
+
+        bool Start();
+        void Stop();
+
+        uint16_t Port() const { return _port; }
+        Statistics Stats() const;
+
+    private:
+        class Connection;
+        friend class Connection;
+
+        void Acceptor();
+        void Dispatch(Connection& connection, const std::string& message);
+        Json Control(const std::string& method, const Json& params, Json& error);
+        uint32_t Delay(const std::string& method, std::mt19937& random) const;
+        double EventRate(const std::string& event) const;
+
+    private:
+        const Specification& _specification;
+        const bool _notificationEvents;
+        int _listener;
+        uint16_t _port;
+        std::atomic<bool> _running;
+        std::thread _acceptor;
+
+        mutable std::mutex _connectionsLock;
+        std::list<std::shared_ptr<Connection>> _connections;
+
+        mutable std::mutex _configLock;
+        uint32_t _latencyMs;
+        uint32_t _jitterMs;
+        double _eventRate;
+        std::map<std::string, uint32_t> _methodLatency;
+        std::map<std::string, double> _eventRates;
+        std::atomic<bool> _stampEvents;
+
+        std::atomic<uint64_t> _connectionCount;
+        std::atomic<uint64_t> _requests;
+        std::atomic<uint64_t> _events;
+        std::atomic<uint64_t> _errors;
+        std::atomic<uint64_t> _bytesReceived;
+        std::atomic<uint64_t> _bytesSent;
+    };
+
+} // namespace FireboltMock
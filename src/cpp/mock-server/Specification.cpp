@@ -0,0 +1,160 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Specification.h"
+#include <algorithm>
+#include <cctype>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+
+namespace FireboltMock {
+
+    static std::string Lowercase(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](const unsigned char character) { return std::tolower(character); });
+        return text;
+    }
+
+    static std::string Capitalize(std::string text)
+    {
+        if (text.empty() == false) {
+            text[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(text[0])));
+        }
+        return text;
+    }
+
+    static bool HasTag(const Json& method, const char* tag)
+    {
+        for (const Json& entry : method["tags"].Elements()) {
+            if (entry["name"].String() == tag) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Specification::Load(const std::string& directory)
+    {
+        DIR* folder = opendir(directory.c_str());
+        if (folder == nullptr) {
+            return false;
+        }
+        std::vector<std::string> files;
+        while (const dirent* entry = readdir(folder)) {
+            const std::string name(entry->d_name);
+            if ((name.size() > 5) && (name.compare(name.size() - 5, 5, ".json") == 0)) {
+                files.push_back(directory + "/" + name);
+            }
+        }
+        closedir(folder);
+        std::sort(files.begin(), files.end());
+
+        bool loaded = false;
+        for (const std::string& file : files) {
+            std::ifstream stream(file);
+            std::stringstream text;
+            text << stream.rdbuf();
+            Json document;
+            if ((Json::Parse(text.str(), document) == true) && (LoadDocument(document) == true)) {
+                loaded = true;
+            }
+        }
+        return loaded;
+    }
+
+    bool Specification::LoadDocument(const Json& document)
+    {
+        const std::string& title = document["info"]["title"].String();
+        if ((title.empty() == true) || (document["methods"].IsArray() == false)) {
+            return false;
+        }
+        const std::string module = Lowercase(title) + ".";
+        for (const Json& entry : document["methods"].Elements()) {
+            Method method;
+            method.name = module + entry["name"].String();
+            method.event = HasTag(entry, "event");
+            for (const Json& example : entry["examples"].Elements()) {
+                Example converted;
+                converted.params = Json::Object();
+                for (const Json& param : example["params"].Elements()) {
+                    converted.params.Set(param["name"].String(), param["value"]);
+                }
+                converted.result = example["result"]["value"];
+                method.examples.push_back(std::move(converted));
+            }
+
+            const bool writable = HasTag(entry, "property");
+            const bool readonly = HasTag(entry, "property:readonly");
+            if ((writable == true) || (readonly == true)) {
+                Method changed;
+                changed.name = module + "on" + Capitalize(entry["name"].String()) + "Changed";
+                changed.event = true;
+                for (const Example& example : method.examples) {
+                    changed.examples.push_back({ Json::Object(), example.result });
+                }
+                Add(std::move(changed), true);
+            }
+            if (writable == true) {
+                Method setter;
+                setter.name = module + "set" + Capitalize(entry["name"].String());
+                setter.event = false;
+                for (const Example& example : method.examples) {
+                    Json params = Json::Object();
+                    params.Set("value", example.result);
+                    setter.examples.push_back({ params, Json() });
+                }
+                Add(std::move(setter), true);
+            }
+            Add(std::move(method), false);
+        }
+        return true;
+    }
+
+    void Specification::Add(Method&& method, const bool derived)
+    {
+        const std::string key = Lowercase(method.name);
+        // Explicitly specified methods win over derived ones of the same name
+        if ((derived == false) || (_methods.find(key) == _methods.end())) {
+            _methods[key] = std::move(method);
+        }
+    }
+
+    const Specification::Method* Specification::Find(const std::string& name) const
+    {
+        const auto entry = _methods.find(Lowercase(name));
+        return (entry != _methods.end()) ? &entry->second : nullptr;
+    }
+
+    /* static */ const Json& Specification::Result(const Method& method, const Json& params)
+    {
+        static const Json null;
+        for (const Example& example : method.examples) {
+            bool matches = (example.params.Members().empty() == false);
+            for (const Json::Member& param : example.params.Members()) {
+                const Json* value = params.IsObject() ? params.Find(param.first) : nullptr;
+                matches = matches && (value != nullptr) && (*value == param.second);
+            }
+            if (matches == true) {
+                return example.result;
+            }
+        }
+        return method.examples.empty() ? null : method.examples.front().result;
+    }
+
+} // namespace FireboltMock
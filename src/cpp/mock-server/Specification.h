@@ -0,0 +1,68 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "Json.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace FireboltMock {
+
+    // The methods of the OpenRPC documents with their example results. Properties get the
+    // methods the SDK generator derives from them: a setter and an on<Name>Changed event,
+    // whose payloads are the getter examples.
+    class Specification {
+    public:
+        struct Example {
+            Json params; // object of parameter name to value
+            Json result;
+        };
+        struct Method {
+            std::string name;
+            bool event;
+            std::vector<Example> examples;
+        };
+
+    public:
+        Specification(const Specification&) = delete;
+        Specification& operator=(const Specification&) = delete;
+
+        Specification() = default;
+        ~Specification() = default;
+
+        // Loads every *.json OpenRPC document of the directory, returns false if none could be loaded
+        bool Load(const std::string& directory);
+        bool LoadDocument(const Json& document);
+
+        // Method names are matched case insensitive, e.g. "device.name" or "Device.name"
+        const Method* Find(const std::string& name) const;
+        size_t Count() const { return _methods.size(); }
+
+        // The result of the first example whose params match, or of the first example
+        static const Json& Result(const Method& method, const Json& params);
+
+    private:
+        void Add(Method&& method, const bool derived);
+
+    private:
+        std::map<std::string, Method> _methods;
+    };
+
+} // namespace FireboltMock
@@ -0,0 +1,360 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "WebSocket.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <random>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace FireboltMock {
+
+    static const char* const WebSocketGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    static constexpr size_t MaxMessageSize = 16 * 1024 * 1024;
+    static constexpr size_t MaxHeaderSize = 16 * 1024;
+
+    std::string Sha1(const std::string& data)
+    {
+        uint32_t hash[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+        std::string message(data);
+        const uint64_t bits = static_cast<uint64_t>(data.size()) * 8;
+        message += static_cast<char>(0x80);
+        while ((message.size() % 64) != 56) {
+            message += static_cast<char>(0);
+        }
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            message += static_cast<char>((bits >> shift) & 0xFF);
+        }
+
+        auto rotate = [](const uint32_t value, const uint32_t count) { return (value << count) | (value >> (32 - count)); };
+        for (size_t chunk = 0; chunk < message.size(); chunk += 64) {
+            uint32_t words[80];
+            for (uint32_t index = 0; index < 16; ++index) {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&message[chunk + (index * 4)]);
+                words[index] = (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+            }
+            for (uint32_t index = 16; index < 80; ++index) {
+                words[index] = rotate(words[index - 3] ^ words[index - 8] ^ words[index - 14] ^ words[index - 16], 1);
+            }
+            uint32_t a = hash[0], b = hash[1], c = hash[2], d = hash[3], e = hash[4];
+            for (uint32_t index = 0; index < 80; ++index) {
+                uint32_t f, k;
+                if (index < 20) {
+                    f = (b & c) | (~b & d);
+                    k = 0x5A827999;
+                } else if (index < 40) {
+                    f = b ^ c ^ d;
+                    k = 0x6ED9EBA1;
+                } else if (index < 60) {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8F1BBCDC;
+                } else {
+                    f = b ^ c ^ d;
+                    k = 0xCA62C1D6;
+                }
+                const uint32_t temp = rotate(a, 5) + f + e + k + words[index];
+                e = d;
+                d = c;
+                c = rotate(b, 30);
+                b = a;
+                a = temp;
+            }
+            hash[0] += a;
+            hash[1] += b;
+            hash[2] += c;
+            hash[3] += d;
+            hash[4] += e;
+        }
+
+        std::string digest;
+        for (const uint32_t word : hash) {
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                digest += static_cast<char>((word >> shift) & 0xFF);
+            }
+        }
+        return digest;
+    }
+
+    std::string Base64(const std::string& data)
+    {
+        static const char* const alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string result;
+        size_t index = 0;
+        for (; (index + 2) < data.size(); index += 3) {
+            const uint32_t triple = (static_cast<uint8_t>(data[index]) << 16) | (static_cast<uint8_t>(data[index + 1]) << 8) | static_cast<uint8_t>(data[index + 2]);
+            result += alphabet[(triple >> 18) & 0x3F];
+            result += alphabet[(triple >> 12) & 0x3F];
+            result += alphabet[(triple >> 6) & 0x3F];
+            result += alphabet[triple & 0x3F];
+        }
+        if (index < data.size()) {
+            const bool two = ((index + 1) < data.size());
+            const uint32_t triple = (static_cast<uint8_t>(data[index]) << 16) | (two ? (static_cast<uint8_t>(data[index + 1]) << 8) : 0);
+            result += alphabet[(triple >> 18) & 0x3F];
+            result += alphabet[(triple >> 12) & 0x3F];
+            result += two ? alphabet[(triple >> 6) & 0x3F] : '=';
+            result += '=';
+        }
+        return result;
+    }
+
+    static std::string HeaderValue(const std::string& headers, const char* name)
+    {
+        const size_t length = strlen(name);
+        size_t line = 0;
+        while (line < headers.size()) {
+            size_t end = headers.find("\r\n", line);
+            end = (end == std::string::npos) ? headers.size() : end;
+            if (((end - line) > length) && (strncasecmp(&headers[line], name, length) == 0) && (headers[line + length] == ':')) {
+                size_t value = line + length + 1;
+                while ((value < end) && (headers[value] == ' ')) {
+                    ++value;
+                }
+                return headers.substr(value, end - value);
+            }
+            line = end + 2;
+        }
+        return std::string();
+    }
+
+    WebSocket::WebSocket()
+        : _socket(-1)
+        , _client(false)
+        , _bytesReceived(0)
+        , _bytesSent(0)
+    {
+    }
+    WebSocket::~WebSocket()
+    {
+        if (_socket >= 0) {
+            ::close(_socket);
+        }
+    }
+
+    bool WebSocket::Fill(const size_t size)
+    {
+        char chunk[4096];
+        while (_buffer.size() < size) {
+            const ssize_t received = ::recv(_socket, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                return false;
+            }
+            _buffer.append(chunk, received);
+            _bytesReceived += received;
+        }
+        return true;
+    }
+
+    bool WebSocket::ReadHeaders(std::string& headers)
+    {
+        size_t end;
+        while ((end = _buffer.find("\r\n\r\n")) == std::string::npos) {
+            if ((_buffer.size() > MaxHeaderSize) || (Fill(_buffer.size() + 1) == false)) {
+                return false;
+            }
+        }
+        headers = _buffer.substr(0, end + 2);
+        _buffer.erase(0, end + 4);
+        return true;
+    }
+
+    bool WebSocket::Accept(const int socket)
+    {
+        _socket = socket;
+        _client = false;
+        const int enable = 1;
+        setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::string headers;
+        if (ReadHeaders(headers) == false) {
+            return false;
+        }
+        const std::string key = HeaderValue(headers, "Sec-WebSocket-Key");
+        if ((headers.compare(0, 4, "GET ") != 0) || (key.empty() == true)) {
+            const std::string response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            ::send(_socket, response.data(), response.size(), MSG_NOSIGNAL);
+            return false;
+        }
+        const std::string response = "HTTP/1.1 101 Switching Protocols\r\n"
+                                     "Upgrade: websocket\r\n"
+                                     "Connection: Upgrade\r\n"
+                                     "Sec-WebSocket-Accept: " + Base64(Sha1(key + WebSocketGuid)) + "\r\n\r\n";
+        return ::send(_socket, response.data(), response.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(response.size());
+    }
+
+    bool WebSocket::Connect(const std::string& host, const uint16_t port, const std::string& path)
+    {
+        _client = true;
+        _socket = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        if ((_socket < 0) || (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1)
+            || (::connect(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)) {
+            return false;
+        }
+        const int enable = 1;
+        setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::random_device random;
+        std::string nonce;
+        for (uint32_t index = 0; index < 16; ++index) {
+            nonce += static_cast<char>(random() & 0xFF);
+        }
+        const std::string key = Base64(nonce);
+        const std::string request = "GET " + path + " HTTP/1.1\r\n"
+                                    "Host: " + host + ":" + std::to_string(port) + "\r\n"
+                                    "Upgrade: websocket\r\n"
+                                    "Connection: Upgrade\r\n"
+                                    "Sec-WebSocket-Key: " + key + "\r\n"
+                                    "Sec-WebSocket-Version: 13\r\n\r\n";
+        std::string headers;
+        return (::send(_socket, request.data(), request.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.size()))
+            && (ReadHeaders(headers) == true)
+            && (headers.compare(0, 12, "HTTP/1.1 101") == 0)
+            && (HeaderValue(headers, "Sec-WebSocket-Accept") == Base64(Sha1(key + WebSocketGuid)));
+    }
+
+    bool WebSocket::Receive(std::string& message)
+    {
+        message.clear();
+        while (true) {
+            if (Fill(2) == false) {
+                return false;
+            }
+            const uint8_t first = static_cast<uint8_t>(_buffer[0]);
+            const uint8_t second = static_cast<uint8_t>(_buffer[1]);
+            const bool final = (first & 0x80) != 0;
+            const uint8_t opcode = first & 0x0F;
+            const bool masked = (second & 0x80) != 0;
+            uint64_t length = second & 0x7F;
+            size_t header = 2;
+            if (length == 126) {
+                if (Fill(4) == false) {
+                    return false;
+                }
+                length = (static_cast<uint8_t>(_buffer[2]) << 8) | static_cast<uint8_t>(_buffer[3]);
+                header = 4;
+            } else if (length == 127) {
+                if (Fill(10) == false) {
+                    return false;
+                }
+                length = 0;
+                for (uint32_t index = 2; index < 10; ++index) {
+                    length = (length << 8) | static_cast<uint8_t>(_buffer[index]);
+                }
+                header = 10;
+            }
+            if ((length + message.size()) > MaxMessageSize) {
+                return false;
+            }
+            const size_t maskOffset = header;
+            header += masked ? 4 : 0;
+            if (Fill(header + length) == false) {
+                return false;
+            }
+            std::string payload = _buffer.substr(header, length);
+            if (masked == true) {
+                for (size_t index = 0; index < payload.size(); ++index) {
+                    payload[index] ^= _buffer[maskOffset + (index % 4)];
+                }
+            }
+            _buffer.erase(0, header + length);
+
+            switch (opcode) {
+            case Ping:
+                SendFrame(Pong, payload);
+                break;
+            case Pong:
+                break;
+            case Closing:
+                SendFrame(Closing, payload.substr(0, 2));
+                return false;
+            case Text:
+            case Binary:
+            case Continuation:
+                message += payload;
+                if (final == true) {
+                    return true;
+                }
+                break;
+            default:
+                return false;
+            }
+        }
+    }
+
+    bool WebSocket::SendFrame(const uint8_t opcode, const std::string& payload)
+    {
+        std::string frame;
+        frame += static_cast<char>(0x80 | opcode);
+        const uint8_t mask = _client ? 0x80 : 0x00;
+        if (payload.size() < 126) {
+            frame += static_cast<char>(mask | payload.size());
+        } else if (payload.size() <= 0xFFFF) {
+            frame += static_cast<char>(mask | 126);
+            frame += static_cast<char>((payload.size() >> 8) & 0xFF);
+            frame += static_cast<char>(payload.size() & 0xFF);
+        } else {
+            frame += static_cast<char>(mask | 127);
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                frame += static_cast<char>((static_cast<uint64_t>(payload.size()) >> shift) & 0xFF);
+            }
+        }
+        if (_client == true) {
+            // Clients have to mask, the key does not need to be unpredictable for the mock
+            static const char key[4] = { 0x12, 0x34, 0x56, 0x78 };
+            frame.append(key, sizeof(key));
+            for (size_t index = 0; index < payload.size(); ++index) {
+                frame += static_cast<char>(payload[index] ^ key[index % 4]);
+            }
+        } else {
+            frame += payload;
+        }
+
+        std::lock_guard<std::mutex> lock(_sendLock);
+        size_t sent = 0;
+        while (sent < frame.size()) {
+            const ssize_t written = ::send(_socket, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0) {
+                return false;
+            }
+            sent += written;
+        }
+        _bytesSent += sent;
+        return true;
+    }
+
+    bool WebSocket::Send(const std::string& message)
+    {
+        return SendFrame(Text, message);
+    }
+
+    void WebSocket::Close()
+    {
+        if (_socket >= 0) {
+            SendFrame(Closing, std::string("\x03\xE8", 2));
+            ::shutdown(_socket, SHUT_RDWR);
+        }
+    }
+
+} // namespace FireboltMock
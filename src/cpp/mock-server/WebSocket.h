@@ -0,0 +1,77 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace FireboltMock {
+
+    std::string Sha1(const std::string& data);
+    std::string Base64(const std::string& data);
+
+    // RFC 6455 text messages over a connected socket, either side of the connection.
+    // Send may be called from any thread, Receive from one thread at a time.
+    class WebSocket {
+    public:
+        WebSocket(const WebSocket&) = delete;
+        WebSocket& operator=(const WebSocket&) = delete;
+
+        WebSocket();
+        ~WebSocket();
+
+        // Server side: takes ownership of an accepted socket and answers the upgrade request
+        bool Accept(const int socket);
+        // Client side, e.g. Connect("127.0.0.1", 9998, "/")
+        bool Connect(const std::string& host, const uint16_t port, const std::string& path);
+
+        // Returns false once the connection is closed or broken
+        bool Receive(std::string& message);
+        bool Send(const std::string& message);
+        void Close();
+
+        uint64_t BytesReceived() const { return _bytesReceived; }
+        uint64_t BytesSent() const { return _bytesSent; }
+
+    private:
+        enum Opcode : uint8_t {
+            Continuation = 0x0,
+            Text = 0x1,
+            Binary = 0x2,
+            Closing = 0x8,
+            Ping = 0x9,
+            Pong = 0xA
+        };
+
+        bool Fill(const size_t size);
+        bool ReadHeaders(std::string& headers);
+        bool SendFrame(const uint8_t opcode, const std::string& payload);
+
+    private:
+        int _socket;
+        bool _client;
+        std::string _buffer;
+        std::mutex _sendLock;
+        std::atomic<uint64_t> _bytesReceived;
+        std::atomic<uint64_t> _bytesSent;
+    };
+
+} // namespace FireboltMock
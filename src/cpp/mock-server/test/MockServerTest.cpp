@@ -0,0 +1,154 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Server.h"
+#include "WebSocket.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(1);                                                                  \
+        }                                                                             \
+    } while (0)
+
+using namespace FireboltMock;
+
+static std::string Hex(const std::string& data)
+{
+    std::string hex;
+    char digits[3];
+    for (const unsigned char byte : data) {
+        snprintf(digits, sizeof(digits), "%02x", byte);
+        hex += digits;
+    }
+    return hex;
+}
+
+static Json Call(WebSocket& client, const uint32_t id, const std::string& method, const std::string& params = "{}")
+{
+    CHECK(client.Send("{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(id) + ",\"method\":\"" + method + "\",\"params\":" + params + "}"));
+    std::string message;
+    Json response;
+    CHECK(client.Receive(message));
+    CHECK(Json::Parse(message, response));
+    CHECK(response["id"].Double() == id);
+    return response;
+}
+
+static void HandshakeTest()
+{
+    CHECK(Hex(Sha1("abc")) == "a9993e364706816aba3e25717850c26c9cd0d89d");
+    // RFC 6455 section 1.3
+    CHECK(Base64(Sha1("dGhlIHNhbXBsZSBub25jZQ==258EAFA5-E914-47DA-95CA-C5AB0DC85B11")) == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+static void JsonTest()
+{
+    const std::string text = "{\"a\":[1,2.50,true,null],\"b\":\"\\u00e9\\n\",\"c\":{}}";
+    Json value;
+    CHECK(Json::Parse(text, value));
+    CHECK(value["a"].Elements().size() == 4);
+    CHECK(value["a"].Elements()[1].ToString() == "2.50");
+    CHECK(value["b"].String() == "\xc3\xa9\n");
+    Json again;
+    CHECK(Json::Parse(value.ToString(), again));
+    CHECK(again == value);
+    CHECK(Json::Parse("{\"a\":}", value) == false);
+}
+
+static void ServerTest()
+{
+    Specification specification;
+    CHECK(specification.Load(FIREBOLT_MOCK_SPEC_PATH));
+    CHECK(specification.Find("Device.onNameChanged") != nullptr);
+
+    Server::Options options;
+    options.port = 0;
+    Server server(specification, options);
+    CHECK(server.Start());
+
+    WebSocket client;
+    CHECK(client.Connect("127.0.0.1", server.Port(), "/"));
+
+    Json response = Call(client, 1, "device.name");
+    CHECK(response["result"].String() == "Living Room");
+
+    response = Call(client, 2, "device.noSuchMethod");
+    CHECK(response["error"]["code"].Double() == -32601);
+
+    // Injected latency
+    Call(client, 3, "mock.setLatency", "{\"ms\":50}");
+    const auto start = std::chrono::steady_clock::now();
+    Call(client, 4, "device.name");
+    CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+    Call(client, 5, "mock.setLatency", "{\"ms\":0}");
+
+    // Periodic events, delivered as responses to the listen request id
+    Call(client, 6, "mock.setEventRate", "{\"perSecond\":100,\"event\":\"device.onNameChanged\"}");
+    response = Call(client, 7, "device.onNameChanged", "{\"listen\":true}");
+    CHECK(response["result"]["listening"].Boolean() == true);
+    for (uint32_t event = 0; event < 5; ++event) {
+        std::string message;
+        CHECK(client.Receive(message));
+        CHECK(Json::Parse(message, response));
+        CHECK(response["id"].Double() == 7);
+        CHECK(response["result"].IsString());
+    }
+    Call(client, 8, "mock.setEventRate", "{\"perSecond\":0}");
+
+    // Skip events that were already on their way
+    std::string message;
+    const std::string stats = "{\"jsonrpc\":\"2.0\",\"id\":9,\"method\":\"mock.stats\"}";
+    CHECK(client.Send(stats));
+    do {
+        CHECK(client.Receive(message));
+        CHECK(Json::Parse(message, response));
+    } while (response["id"].Double() != 9);
+    CHECK(response["result"]["connections"].Double() == 1);
+    CHECK(response["result"]["requests"].Double() == 9);
+    CHECK(response["result"]["errors"].Double() == 1);
+    CHECK(response["result"]["events"].Double() >= 5);
+
+    // Object payloads carry the send time when stamping is on
+    Call(client, 10, "mock.setEventRate", "{\"perSecond\":0,\"stamp\":true}");
+    Call(client, 11, "lifecycle.onForeground", "{\"listen\":true}");
+    CHECK(client.Send("{\"jsonrpc\":\"2.0\",\"id\":12,\"method\":\"mock.emit\",\"params\":{\"event\":\"lifecycle.onForeground\"}}"));
+    do {
+        CHECK(client.Receive(message));
+        CHECK(Json::Parse(message, response));
+    } while (response["id"].Double() != 11);
+    CHECK(response["result"]["state"].String() == "foreground");
+    CHECK(response["result"]["sentUs"].Double() > 0);
+
+    client.Close();
+    server.Stop();
+    CHECK(server.Stats().bytesSent > 0);
+}
+
+int main()
+{
+    HandshakeTest();
+    JsonTest();
+    ServerTest();
+    printf("FireboltMockServerTest passed\n");
+    return 0;
+}
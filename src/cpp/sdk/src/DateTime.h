@@ -0,0 +1,92 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "FireboltSDK.h"
+#include "Parse.h"
+
+namespace FireboltSDK {
+
+    // Drop in for the Core::JSON::String of a "date-time" field: the text is kept as is and
+    // parsed into a Timestamp once, when it is decoded or assigned, instead of by every reader.
+    //
+    //     FireboltSDK::DateTime Expires;
+    //     if (jsonResult.Expires.Time().IsValid() == true) { ... jsonResult.Expires.Time().Time() ... }
+    class DateTime : public WPEFramework::Core::JSON::String {
+    public:
+        DateTime()
+            : WPEFramework::Core::JSON::String()
+            , _timestamp()
+        {
+        }
+        DateTime(const DateTime& copy)
+            : WPEFramework::Core::JSON::String(copy)
+            , _timestamp(copy._timestamp)
+        {
+        }
+        ~DateTime() override = default;
+
+        DateTime& operator=(const DateTime& RHS)
+        {
+            WPEFramework::Core::JSON::String::operator=(RHS);
+            _timestamp = RHS._timestamp;
+            return (*this);
+        }
+        DateTime& operator=(const string& RHS)
+        {
+            WPEFramework::Core::JSON::String::operator=(RHS);
+            Update();
+            return (*this);
+        }
+
+        // Invalid if the field is not set or not a date-time
+        const Timestamp& Time() const
+        {
+            return _timestamp;
+        }
+
+        void Clear() override
+        {
+            WPEFramework::Core::JSON::String::Clear();
+            _timestamp = Timestamp();
+        }
+        uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint32_t& offset, WPEFramework::Core::OptionalType<WPEFramework::Core::JSON::Error>& error) override
+        {
+            const uint16_t loaded = WPEFramework::Core::JSON::String::Deserialize(stream, maxLength, offset, error);
+            // A non zero offset means the string continues in the next chunk
+            if (offset == 0) {
+                Update();
+            }
+            return loaded;
+        }
+
+    private:
+        void Update()
+        {
+            _timestamp = Timestamp();
+            if ((IsSet() == true) && (IsNull() == false)) {
+                Timestamp::Parse(Value(), _timestamp);
+            }
+        }
+
+    private:
+        Timestamp _timestamp;
+    };
+
+} // namespace FireboltSDK
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <type_traits>
+
+namespace FireboltSDK {
+
+    // Direct call access to a module implementation, for apps building against the SDK
+    // sources. The accessor hands out the interface, e.g. Device::IDevice&, every call on it
+    // is a virtual call. The implementations are final, so calls made through the reference
+    // returned here bind statically and can be inlined, across units as well with LTO.
+    //
+    //     Firebolt::Lifecycle::LifecycleImpl& lifecycle = FireboltSDK::Direct<Firebolt::Lifecycle::LifecycleImpl>(
+    //         Firebolt::IFireboltAccessor::Instance().LifecycleInterface());
+    //     lifecycle.state();
+    template <typename IMPLEMENTATION, typename INTERFACE>
+    inline IMPLEMENTATION& Direct(INTERFACE& module)
+    {
+        static_assert(std::is_final<IMPLEMENTATION>::value, "only final implementations bind statically");
+        static_assert(std::is_base_of<INTERFACE, IMPLEMENTATION>::value, "IMPLEMENTATION does not implement INTERFACE");
+        return static_cast<IMPLEMENTATION&>(module);
+    }
+
+} // namespace FireboltSDK
@@ -0,0 +1,337 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "Memory.h"
+#include "Probes.h"
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace FireboltSDK {
+
+    // Log-linear (HDR style) histogram of microsecond latencies: 8 linear sub-buckets per
+    // power of two, so any reported percentile is within 12.5% of the recorded value.
+    // Counters are spread over a few shards picked per thread and updated with relaxed
+    // atomics, recording never takes a lock and threads hardly ever share a cache line.
+    class LatencyHistogram {
+    private:
+        static constexpr uint32_t SubBucketBits = 4;
+        static constexpr uint32_t HalfSubBuckets = 1 << (SubBucketBits - 1);
+        static constexpr uint32_t MaxExponent = 31; // ~71 minutes, larger values are clamped
+        static constexpr uint32_t BucketCount = (MaxExponent - SubBucketBits + 2) * HalfSubBuckets + HalfSubBuckets;
+        static constexpr uint32_t ShardCount = 4;
+
+        struct alignas(64) Shard {
+            std::atomic<uint32_t> counts[BucketCount];
+            std::atomic<uint64_t> max;
+        };
+
+    public:
+        struct Summary {
+            uint64_t count;
+            uint64_t p50;
+            uint64_t p90;
+            uint64_t p99;
+            uint64_t max;
+        };
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        LatencyHistogram()
+        {
+            for (Shard& shard : _shards) {
+                for (std::atomic<uint32_t>& count : shard.counts) {
+                    count.store(0, std::memory_order_relaxed);
+                }
+                shard.max.store(0, std::memory_order_relaxed);
+            }
+        }
+        ~LatencyHistogram() = default;
+
+        void Record(const uint64_t microseconds)
+        {
+            Shard& shard = _shards[ShardIndex()];
+            shard.counts[BucketOf(microseconds)].fetch_add(1, std::memory_order_relaxed);
+            uint64_t max = shard.max.load(std::memory_order_relaxed);
+            while ((microseconds > max) && (shard.max.compare_exchange_weak(max, microseconds, std::memory_order_relaxed) == false)) {
+            }
+        }
+
+        Summary Summarize() const
+        {
+            uint64_t counts[BucketCount] = {};
+            Summary summary = {};
+            for (const Shard& shard : _shards) {
+                for (uint32_t bucket = 0; bucket < BucketCount; ++bucket) {
+                    const uint32_t count = shard.counts[bucket].load(std::memory_order_relaxed);
+                    counts[bucket] += count;
+                    summary.count += count;
+                }
+                summary.max = std::max(summary.max, shard.max.load(std::memory_order_relaxed));
+            }
+            summary.p50 = std::min(Percentile(counts, summary.count, 50), summary.max);
+            summary.p90 = std::min(Percentile(counts, summary.count, 90), summary.max);
+            summary.p99 = std::min(Percentile(counts, summary.count, 99), summary.max);
+            return summary;
+        }
+
+    private:
+        static uint32_t BucketOf(const uint64_t value)
+        {
+            if (value < (2 * HalfSubBuckets)) {
+                return static_cast<uint32_t>(value);
+            }
+            const uint32_t exponent = std::min<uint32_t>(63 - __builtin_clzll(value), MaxExponent);
+            const uint32_t shift = exponent - SubBucketBits + 1;
+            const uint64_t subBucket = std::min<uint64_t>(value >> shift, (2 * HalfSubBuckets) - 1);
+            return (shift + 1) * HalfSubBuckets + static_cast<uint32_t>(subBucket - HalfSubBuckets);
+        }
+        // Highest value that still lands in the bucket
+        static uint64_t ValueOf(const uint32_t bucket)
+        {
+            if (bucket < (2 * HalfSubBuckets)) {
+                return bucket;
+            }
+            const uint32_t shift = (bucket / HalfSubBuckets) - 1;
+            const uint64_t subBucket = (bucket % HalfSubBuckets) + HalfSubBuckets;
+            return ((subBucket + 1) << shift) - 1;
+        }
+        static uint64_t Percentile(const uint64_t (&counts)[BucketCount], const uint64_t total, const uint32_t percentile)
+        {
+            const uint64_t rank = (total * percentile + 99) / 100;
+            uint64_t seen = 0;
+            for (uint32_t bucket = 0; (bucket < BucketCount) && (rank > 0); ++bucket) {
+                seen += counts[bucket];
+                if (seen >= rank) {
+                    return ValueOf(bucket);
+                }
+            }
+            return 0;
+        }
+        static uint32_t ShardIndex()
+        {
+            static std::atomic<uint32_t> next { 0 };
+            static thread_local const uint32_t index = next.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+            return index;
+        }
+
+    private:
+        Shard _shards[ShardCount];
+    };
+
+    // Per method latency registry. Every method gets a histogram for the send-to-reply
+    // time of the transport Invoke and one for decoding the reply into the public types.
+    class Latency {
+    private:
+        static constexpr uint32_t TableSize = 128; // power of 2, well above the method count of a module set
+
+        struct Entry {
+            Entry(const char* method, const uint32_t methodHash)
+                : name(method)
+                , hash(methodHash)
+            {
+            }
+            const std::string name;
+            const uint32_t hash;
+            LatencyHistogram invoke;
+            LatencyHistogram decode;
+        };
+
+    public:
+        struct MethodLatency {
+            std::string method;
+            LatencyHistogram::Summary invoke;
+            LatencyHistogram::Summary decode;
+        };
+
+        // Times a single call: construct before building the parameters, call Encoded() right
+        // before and Replied() right after Invoke, the decoding of the reply is timed until the
+        // Timer goes out of scope. Without Encoded() the invoke time starts at construction.
+        // While Trace is started the same phases are recorded as spans of one correlation id.
+        // Allocations between Encoded() and Replied() are tagged "transport" for Memory, the
+        // same with and without memory accounting, so the inline bodies match in every unit.
+        class Timer {
+        public:
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+
+            explicit Timer(const char* method)
+                : Timer(method, Latency::Hash(method))
+            {
+            }
+            // For a method hash known up front, see FireboltSDK::Method
+            Timer(const char* method, const uint32_t hash)
+                : _entry(Latency::Instance().Find(method, hash))
+                , _method(_entry.name.c_str())
+                , _id(Trace::Instance().Correlate())
+                , _start(Trace::Now())
+                , _encoded(_start)
+                , _replied(0)
+                , _memoryTag(NoTag)
+            {
+            }
+            ~Timer()
+            {
+                LeaveTransport();
+                if (_replied != 0) {
+                    const uint64_t end = Trace::Now();
+                    _entry.decode.Record((end - _replied) / 1000);
+                    if (_id != 0) {
+                        Trace::Instance().Record(_method, "decode", _id, _replied, end);
+                    }
+                }
+            }
+
+            void Encoded()
+            {
+                static const uint8_t transportTag = Memory::Instance().Register("transport");
+                _memoryTag = Memory::Current();
+                Memory::Current() = transportTag;
+                _encoded = Trace::Now();
+                if (_id != 0) {
+                    Trace::Instance().Record(_method, "serialize", _id, _start, _encoded);
+                }
+            }
+            void Replied()
+            {
+                _replied = Trace::Now();
+                LeaveTransport();
+                _entry.invoke.Record((_replied - _encoded) / 1000);
+                if (_id != 0) {
+                    Trace::Instance().Record(_method, "invoke", _id, _encoded, _replied);
+                }
+            }
+
+            // Same as above, additionally firing the request__send/response__receive probes
+            template <typename PARAMETERS>
+            void Encoded(const PARAMETERS& parameters)
+            {
+                Encoded();
+                FIREBOLT_PROBE_REQUEST_SEND(_method, _id, parameters);
+            }
+            template <typename STATUS, typename RESULT>
+            void Replied(const STATUS status, const RESULT& result)
+            {
+                Replied();
+                FIREBOLT_PROBE_RESPONSE_RECEIVE(_method, _id, static_cast<int>(status), result);
+            }
+
+        private:
+            static constexpr uint8_t NoTag = 0xFF;
+
+            void LeaveTransport()
+            {
+                if (_memoryTag != NoTag) {
+                    Memory::Current() = _memoryTag;
+                    _memoryTag = NoTag;
+                }
+            }
+
+        private:
+            Entry& _entry;
+            const char* _method;
+            const uint64_t _id;
+            const uint64_t _start;
+            uint64_t _encoded;
+            uint64_t _replied;
+            uint8_t _memoryTag; // tag to return to after the transport call
+        };
+
+    public:
+        Latency(const Latency&) = delete;
+        Latency& operator=(const Latency&) = delete;
+
+        static Latency& Instance()
+        {
+            static Latency instance;
+            return instance;
+        }
+
+        std::vector<MethodLatency> Snapshot() const
+        {
+            std::vector<MethodLatency> snapshot;
+            for (const std::atomic<Entry*>& slot : _table) {
+                const Entry* entry = slot.load(std::memory_order_acquire);
+                if (entry != nullptr) {
+                    snapshot.push_back({ entry->name, entry->invoke.Summarize(), entry->decode.Summarize() });
+                }
+            }
+            return snapshot;
+        }
+
+        // FNV-1a of the method name, usable at compile time
+        static constexpr uint32_t Hash(const char* method)
+        {
+            uint32_t hash = 2166136261u;
+            while (*method != '\0') {
+                hash = (hash ^ static_cast<uint8_t>(*method++)) * 16777619u;
+            }
+            return hash;
+        }
+
+    private:
+        Latency()
+        {
+            for (std::atomic<Entry*>& slot : _table) {
+                slot.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        ~Latency()
+        {
+            for (std::atomic<Entry*>& slot : _table) {
+                delete slot.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Lock free for known methods, a method seen for the first time is added under _adminLock
+        Entry& Find(const char* method, const uint32_t hash)
+        {
+            for (uint32_t probe = 0; probe < TableSize; ++probe) {
+                std::atomic<Entry*>& slot = _table[(hash + probe) & (TableSize - 1)];
+                Entry* entry = slot.load(std::memory_order_acquire);
+                if (entry == nullptr) {
+                    std::lock_guard<std::mutex> lock(_adminLock);
+                    entry = slot.load(std::memory_order_acquire);
+                    if (entry == nullptr) {
+                        entry = new Entry(method, hash);
+                        slot.store(entry, std::memory_order_release);
+                        return *entry;
+                    }
+                }
+                if ((entry->hash == hash) && (entry->name == method)) {
+                    return *entry;
+                }
+            }
+            // Table is full, account the call to the overflow entry instead
+            return _overflow;
+        }
+
+    private:
+        std::atomic<Entry*> _table[TableSize];
+        Entry _overflow { "<other>", 0 };
+        std::mutex _adminLock;
+    };
+
+} // namespace FireboltSDK
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace FireboltSDK {
+
+    // Heap accounting per SDK area (module implementations, transport, event registry).
+    // The code of an area runs inside FIREBOLT_MEMORY_SCOPE("name"), which tags the calling
+    // thread; every allocation is charged to the tag active when it was made, also when it
+    // is freed elsewhere. Allocations outside any scope are "unattributed".
+    //
+    // Counting needs -DFIREBOLT_MEMORY_ACCOUNTING for the SDK and an application that routes
+    // operator new/delete here with FIREBOLT_MEMORY_ACCOUNTING_HOOKS in one of its sources.
+    // Each allocation then carries a 16 byte header, over-aligned ones their alignment on top.
+    class Memory {
+    public:
+        static constexpr uint32_t MaxTags = 32;
+
+        struct Usage {
+            const char* tag;
+            int64_t current;
+            int64_t peak;
+            uint64_t allocations;
+        };
+
+        // Tags the allocations of the current thread until it goes out of scope
+        class Scope {
+        public:
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            explicit Scope(const uint8_t tag)
+                : _previous(Current())
+            {
+                Current() = tag;
+            }
+            ~Scope()
+            {
+                Current() = _previous;
+            }
+
+        private:
+            const uint8_t _previous;
+        };
+
+    private:
+        // Right before the pointer handed out, offset bytes after the one malloc returned
+        struct alignas(alignof(std::max_align_t)) Header {
+            uint64_t size;
+            uint32_t tag;
+            uint32_t offset;
+        };
+
+        struct Counters {
+            std::atomic<const char*> name;
+            std::atomic<int64_t> current;
+            std::atomic<int64_t> peak;
+            std::atomic<uint64_t> allocations;
+        };
+
+    public:
+        Memory(const Memory&) = delete;
+        Memory& operator=(const Memory&) = delete;
+
+        // Constant initialized and trivially destructible: operator new may get here before
+        // main and operator delete after the static destructors ran
+        static Memory& Instance()
+        {
+            static Memory instance;
+            return instance;
+        }
+
+        static uint8_t& Current()
+        {
+            static thread_local uint8_t tag = 0;
+            return tag;
+        }
+
+        // Name has to be a string literal, returns the tag to pass to Scope
+        uint8_t Register(const char* name)
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            const uint32_t count = _count.load(std::memory_order_relaxed);
+            for (uint32_t index = 0; index < count; ++index) {
+                const char* known = _counters[index].name.load(std::memory_order_relaxed);
+                if ((known == name) || (std::strcmp(known, name) == 0)) {
+                    return static_cast<uint8_t>(index);
+                }
+            }
+            if (count == MaxTags) {
+                return 0;
+            }
+            _counters[count].name.store(name, std::memory_order_relaxed);
+            _count.store(count + 1, std::memory_order_release);
+            return static_cast<uint8_t>(count);
+        }
+
+        // alignment is a power of 2
+        void* Allocate(const size_t size, const size_t alignment = alignof(Header))
+        {
+            const size_t padding = (alignment > alignof(Header)) ? alignment : 0;
+            uint8_t* base = static_cast<uint8_t*>(std::malloc(sizeof(Header) + padding + size));
+            if (base == nullptr) {
+                return nullptr;
+            }
+            const uintptr_t address = (reinterpret_cast<uintptr_t>(base) + sizeof(Header) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            Header* header = reinterpret_cast<Header*>(address) - 1;
+            header->offset = static_cast<uint32_t>(address - reinterpret_cast<uintptr_t>(base));
+            header->size = size;
+            header->tag = Current();
+            Counters& counters = _counters[header->tag];
+            const int64_t current = counters.current.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            int64_t peak = counters.peak.load(std::memory_order_relaxed);
+            while ((current > peak) && (counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed) == false)) {
+            }
+            return header + 1;
+        }
+        void Free(void* pointer)
+        {
+            if (pointer != nullptr) {
+                Header* header = static_cast<Header*>(pointer) - 1;
+                _counters[header->tag].current.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+                std::free(static_cast<uint8_t*>(pointer) - header->offset);
+            }
+        }
+
+        std::vector<Usage> Snapshot() const
+        {
+            std::vector<Usage> snapshot;
+            const uint32_t count = _count.load(std::memory_order_acquire);
+            snapshot.reserve(count);
+            for (uint32_t index = 0; index < count; ++index) {
+                const Counters& counters = _counters[index];
+                snapshot.push_back({ counters.name.load(std::memory_order_relaxed), counters.current.load(std::memory_order_relaxed),
+                    counters.peak.load(std::memory_order_relaxed), counters.allocations.load(std::memory_order_relaxed) });
+            }
+            return snapshot;
+        }
+
+        // Allocations made so far over all tags, does not allocate itself
+        uint64_t Allocations() const
+        {
+            uint64_t allocations = 0;
+            const uint32_t count = _count.load(std::memory_order_acquire);
+            for (uint32_t index = 0; index < count; ++index) {
+                allocations += _counters[index].allocations.load(std::memory_order_relaxed);
+            }
+            return allocations;
+        }
+
+        // Starts a new peak measurement from the current usage
+        void ResetPeaks()
+        {
+            for (Counters& counters : _counters) {
+                counters.peak.store(counters.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        constexpr Memory()
+            : _counters { { { "unattributed" }, { 0 }, { 0 }, { 0 } } }
+            , _count(1)
+        {
+        }
+        ~Memory() = default;
+
+    private:
+        Counters _counters[MaxTags];
+        std::atomic<uint32_t> _count;
+        std::mutex _adminLock;
+    };
+
+} // namespace FireboltSDK
+
+#ifdef FIREBOLT_MEMORY_ACCOUNTING
+
+#define FIREBOLT_MEMORY_CONCAT_(a, b) a##b
+#define FIREBOLT_MEMORY_CONCAT(a, b) FIREBOLT_MEMORY_CONCAT_(a, b)
+
+#define FIREBOLT_MEMORY_SCOPE(name)                                                                                              \
+    static const uint8_t FIREBOLT_MEMORY_CONCAT(_memoryTag, __LINE__) = FireboltSDK::Memory::Instance().Register(name);          \
+    FireboltSDK::Memory::Scope FIREBOLT_MEMORY_CONCAT(_memoryScope, __LINE__)(FIREBOLT_MEMORY_CONCAT(_memoryTag, __LINE__))
+
+// Replaces the global operator new/delete, expand in exactly one source file of the application.
+// Kept out of line, GCC otherwise pairs the malloc inside with the replaced delete and warns.
+#define FIREBOLT_MEMORY_ACCOUNTING_HOOKS                                                                                        \
+    __attribute__((noinline)) void* operator new(std::size_t size)                                                              \
+    {                                                                                                                            \
+        void* pointer = FireboltSDK::Memory::Instance().Allocate(size);                                                         \
+        if (pointer == nullptr) {                                                                                                \
+            throw std::bad_alloc();                                                                                              \
+        }                                                                                                                        \
+        return pointer;                                                                                                          \
+    }                                                                                                                            \
+    __attribute__((noinline)) void* operator new[](std::size_t size) { return operator new(size); }                             \
+    __attribute__((noinline)) void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return FireboltSDK::Memory::Instance().Allocate(size); } \
+    __attribute__((noinline)) void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return FireboltSDK::Memory::Instance().Allocate(size); } \
+    __attribute__((noinline)) void operator delete(void* pointer) noexcept { FireboltSDK::Memory::Instance().Free(pointer); }   \
+    __attribute__((noinline)) void operator delete[](void* pointer) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete(void* pointer, std::size_t) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete[](void* pointer, std::size_t) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete(void* pointer, const std::nothrow_t&) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete[](void* pointer, const std::nothrow_t&) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void* operator new(std::size_t size, std::align_val_t alignment)                                  \
+    {                                                                                                                            \
+        void* pointer = FireboltSDK::Memory::Instance().Allocate(size, static_cast<std::size_t>(alignment));                    \
+        if (pointer == nullptr) {                                                                                                \
+            throw std::bad_alloc();                                                                                              \
+        }                                                                                                                        \
+        return pointer;                                                                                                          \
+    }                                                                                                                            \
+    __attribute__((noinline)) void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); } \
+    __attribute__((noinline)) void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return FireboltSDK::Memory::Instance().Allocate(size, static_cast<std::size_t>(alignment)); } \
+    __attribute__((noinline)) void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return FireboltSDK::Memory::Instance().Allocate(size, static_cast<std::size_t>(alignment)); } \
+    __attribute__((noinline)) void operator delete(void* pointer, std::align_val_t) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete[](void* pointer, std::align_val_t) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { FireboltSDK::Memory::Instance().Free(pointer); } \
+    __attribute__((noinline)) void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { FireboltSDK::Memory::Instance().Free(pointer); }
+
+#else
+
+#define FIREBOLT_MEMORY_SCOPE(name) do { } while (0)
+
+#endif
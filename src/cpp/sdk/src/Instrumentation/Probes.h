@@ -0,0 +1,90 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+// Linux USDT probes of provider "firebolt", compiled in with -DFIREBOLT_USDT (needs
+// sys/sdt.h from systemtap-sdt-dev). Without it no probe generates any code.
+//
+//   request__send      method, id, parameter bytes
+//   response__receive  method, id, status, result bytes
+//   event__receive     event, payload bytes
+//   callback__start    event
+//   callback__finish   event
+//   reconnect          events replayed once the connection is back
+//
+// e.g. bpftrace -e 'usdt:./app:firebolt:request__send { printf("%s %d\n", str(arg0), arg2); }'
+// Byte sizes need the JSON to be serialized once more, which only happens while a tool is
+// attached to the probe (probe semaphore set).
+
+#ifdef FIREBOLT_USDT
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <string>
+#include <sys/sdt.h>
+
+#define FIREBOLT_PROBE_SEMAPHORE(name) \
+    extern "C" { __attribute__((weak, section(".probes"))) volatile unsigned short firebolt_##name##_semaphore = 0; }
+
+FIREBOLT_PROBE_SEMAPHORE(request__send)
+FIREBOLT_PROBE_SEMAPHORE(response__receive)
+FIREBOLT_PROBE_SEMAPHORE(event__receive)
+FIREBOLT_PROBE_SEMAPHORE(callback__start)
+FIREBOLT_PROBE_SEMAPHORE(callback__finish)
+FIREBOLT_PROBE_SEMAPHORE(reconnect)
+
+namespace FireboltSDK {
+    namespace Probes {
+        template <typename ELEMENT>
+        inline size_t SizeOf(const ELEMENT& element)
+        {
+            std::string text;
+            element.ToString(text);
+            return text.size();
+        }
+    }
+}
+
+#define FIREBOLT_PROBE_ENABLED(name) __builtin_expect(firebolt_##name##_semaphore != 0, 0)
+
+#define FIREBOLT_PROBE_REQUEST_SEND(method, id, parameters) \
+    do { if (FIREBOLT_PROBE_ENABLED(request__send)) { STAP_PROBE3(firebolt, request__send, method, id, FireboltSDK::Probes::SizeOf(parameters)); } } while (0)
+#define FIREBOLT_PROBE_RESPONSE_RECEIVE(method, id, status, result) \
+    do { if (FIREBOLT_PROBE_ENABLED(response__receive)) { STAP_PROBE4(firebolt, response__receive, method, id, status, FireboltSDK::Probes::SizeOf(result)); } } while (0)
+#define FIREBOLT_PROBE_EVENT_RECEIVE(event, payload) \
+    do { if (FIREBOLT_PROBE_ENABLED(event__receive)) { STAP_PROBE2(firebolt, event__receive, event, FireboltSDK::Probes::SizeOf(payload)); } } while (0)
+#define FIREBOLT_PROBE_CALLBACK_START(event) \
+    do { if (FIREBOLT_PROBE_ENABLED(callback__start)) { STAP_PROBE1(firebolt, callback__start, event); } } while (0)
+#define FIREBOLT_PROBE_CALLBACK_FINISH(event) \
+    do { if (FIREBOLT_PROBE_ENABLED(callback__finish)) { STAP_PROBE1(firebolt, callback__finish, event); } } while (0)
+#define FIREBOLT_PROBE_RECONNECT(pending) \
+    do { if (FIREBOLT_PROBE_ENABLED(reconnect)) { STAP_PROBE1(firebolt, reconnect, pending); } } while (0)
+
+#else
+
+// Arguments only appear in an unevaluated sizeof, so they are never computed
+#define FIREBOLT_PROBE_UNUSED(...) do { (void)sizeof((__VA_ARGS__)); } while (0)
+
+#define FIREBOLT_PROBE_REQUEST_SEND(method, id, parameters) FIREBOLT_PROBE_UNUSED(method, id, parameters)
+#define FIREBOLT_PROBE_RESPONSE_RECEIVE(method, id, status, result) FIREBOLT_PROBE_UNUSED(method, id, status, result)
+#define FIREBOLT_PROBE_EVENT_RECEIVE(event, payload) FIREBOLT_PROBE_UNUSED(event, payload)
+#define FIREBOLT_PROBE_CALLBACK_START(event) FIREBOLT_PROBE_UNUSED(event)
+#define FIREBOLT_PROBE_CALLBACK_FINISH(event) FIREBOLT_PROBE_UNUSED(event)
+#define FIREBOLT_PROBE_RECONNECT(pending) FIREBOLT_PROBE_UNUSED(pending)
+
+#endif
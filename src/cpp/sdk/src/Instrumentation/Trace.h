@@ -0,0 +1,240 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace FireboltSDK {
+
+    // Optional span recorder for SDK calls and event dispatch. While started, every span is
+    // written into a fixed size binary ring (oldest spans are overwritten) and the ring can be
+    // exported as Chrome trace JSON, loadable in chrome://tracing or ui.perfetto.dev.
+    // Name and phase have to be string literals, only the pointers are stored.
+    class Trace {
+    private:
+        struct Slot {
+            std::atomic<uint64_t> sequence; // 0 while being written
+            std::atomic<const char*> name;
+            std::atomic<const char*> phase;
+            std::atomic<uint64_t> start;
+            std::atomic<uint64_t> duration;
+            std::atomic<uint64_t> id;
+            std::atomic<uint32_t> thread;
+        };
+
+        struct Ring {
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+            explicit Ring(const uint32_t size)
+                : mask(size - 1)
+                , next(0)
+                , slots(new Slot[size])
+            {
+                for (uint32_t index = 0; index < size; ++index) {
+                    slots[index].sequence.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            const uint32_t mask;
+            std::atomic<uint64_t> next;
+            std::unique_ptr<Slot[]> slots;
+        };
+
+    public:
+        // Times one phase of a call from construction until destruction
+        class Span {
+        public:
+            Span(const Span&) = delete;
+            Span& operator=(const Span&) = delete;
+
+            Span(const char* name, const char* phase, const uint64_t id = 0)
+                : _name(name)
+                , _phase(phase)
+                , _id(id)
+                , _start(Trace::Instance().IsEnabled() ? Trace::Now() : 0)
+            {
+            }
+            ~Span()
+            {
+                if (_start != 0) {
+                    Trace::Instance().Record(_name, _phase, _id, _start, Trace::Now());
+                }
+            }
+
+        private:
+            const char* _name;
+            const char* _phase;
+            const uint64_t _id;
+            const uint64_t _start;
+        };
+
+    public:
+        Trace(const Trace&) = delete;
+        Trace& operator=(const Trace&) = delete;
+
+        static Trace& Instance()
+        {
+            static Trace instance;
+            return instance;
+        }
+
+        // Capacity is rounded up to a power of 2. Restarting keeps the spans recorded so far
+        // unless the capacity changes.
+        void Start(const uint32_t capacity)
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            uint32_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            const Ring* ring = _ring.load(std::memory_order_relaxed);
+            if ((ring == nullptr) || (ring->mask + 1 != size)) {
+                // A Record() that loaded the previous ring may still write into it, so rings
+                // are only freed at exit
+                _rings.emplace_back(new Ring(size));
+                _ring.store(_rings.back().get(), std::memory_order_release);
+            }
+            _enabled.store(true, std::memory_order_release);
+        }
+        void Stop()
+        {
+            _enabled.store(false, std::memory_order_release);
+        }
+        bool IsEnabled() const
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        // Correlates the phases of one call, 0 means no one is going to look at it
+        uint64_t Correlate()
+        {
+#ifdef FIREBOLT_USDT
+            return _correlation.fetch_add(1, std::memory_order_relaxed) + 1;
+#else
+            return (IsEnabled() == true) ? _correlation.fetch_add(1, std::memory_order_relaxed) + 1 : 0;
+#endif
+        }
+
+        static uint64_t Now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void Record(const char* name, const char* phase, const uint64_t id, const uint64_t start, const uint64_t end)
+        {
+            if (_enabled.load(std::memory_order_acquire) == true) {
+                Ring& ring = *_ring.load(std::memory_order_acquire);
+                const uint64_t position = ring.next.fetch_add(1, std::memory_order_relaxed);
+                Slot& slot = ring.slots[position & ring.mask];
+                slot.sequence.store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.name.store(name, std::memory_order_relaxed);
+                slot.phase.store(phase, std::memory_order_relaxed);
+                slot.start.store(start, std::memory_order_relaxed);
+                slot.duration.store(end - start, std::memory_order_relaxed);
+                slot.id.store(id, std::memory_order_relaxed);
+                slot.thread.store(ThreadId(), std::memory_order_relaxed);
+                slot.sequence.store(position + 1, std::memory_order_release);
+            }
+        }
+
+        // Chrome trace event format, one complete ("X") event per span
+        std::string Export() const
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            std::string json("{\"traceEvents\":[");
+            const Ring* ring = _ring.load(std::memory_order_acquire);
+            const uint64_t capacity = (ring != nullptr) ? (ring->mask + 1) : 0;
+            const uint64_t next = (ring != nullptr) ? ring->next.load(std::memory_order_acquire) : 0;
+            const uint64_t first = (next > capacity) ? (next - capacity) : 0;
+            const int process = static_cast<int>(getpid());
+            bool separator = false;
+            for (uint64_t position = first; position < next; ++position) {
+                const Slot& slot = ring->slots[position & ring->mask];
+                if (slot.sequence.load(std::memory_order_acquire) != (position + 1)) {
+                    continue;
+                }
+                const char* name = slot.name.load(std::memory_order_relaxed);
+                const char* phase = slot.phase.load(std::memory_order_relaxed);
+                const uint64_t start = slot.start.load(std::memory_order_relaxed);
+                const uint64_t duration = slot.duration.load(std::memory_order_relaxed);
+                const uint64_t id = slot.id.load(std::memory_order_relaxed);
+                const uint32_t thread = slot.thread.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != (position + 1)) {
+                    continue; // overwritten while reading
+                }
+                char event[256];
+                snprintf(event, sizeof(event), "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"pid\":%d,\"tid\":%u,\"args\":{\"id\":%llu}}",
+                    (separator ? "," : ""), name, phase,
+                    static_cast<unsigned long long>(start / 1000), static_cast<uint32_t>(start % 1000),
+                    static_cast<unsigned long long>(duration / 1000), static_cast<uint32_t>(duration % 1000),
+                    process, thread, static_cast<unsigned long long>(id));
+                json += event;
+                separator = true;
+            }
+            json += "]}";
+            return json;
+        }
+        bool Export(const std::string& path) const
+        {
+            bool exported = false;
+            FILE* file = fopen(path.c_str(), "w");
+            if (file != nullptr) {
+                const std::string json = Export();
+                exported = (fwrite(json.data(), 1, json.size(), file) == json.size());
+                exported = (fclose(file) == 0) && exported;
+            }
+            return exported;
+        }
+
+    private:
+        Trace()
+            : _enabled(false)
+            , _ring(nullptr)
+            , _correlation(0)
+        {
+        }
+        ~Trace() = default;
+
+        static uint32_t ThreadId()
+        {
+            static thread_local const uint32_t thread = static_cast<uint32_t>(syscall(SYS_gettid));
+            return thread;
+        }
+
+    private:
+        std::atomic<bool> _enabled;
+        std::atomic<Ring*> _ring;
+        std::atomic<uint64_t> _correlation;
+        std::vector<std::unique_ptr<Ring>> _rings;
+        mutable std::mutex _adminLock;
+    };
+
+} // namespace FireboltSDK
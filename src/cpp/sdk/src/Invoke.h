@@ -0,0 +1,167 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "FireboltSDK.h"
+#include "Logger/AsyncLogger.h"
+#include "Instrumentation/Latency.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace FireboltSDK {
+
+    // Method name with its latency registry hash. Declared constexpr, the hash is computed
+    // at compile time; from a runtime name it is computed on construction.
+    class Method {
+    public:
+        constexpr Method(const char* name)
+            : _name(name)
+            , _hash(Latency::Hash(name))
+        {
+        }
+
+        constexpr const char* Name() const
+        {
+            return _name;
+        }
+        constexpr uint32_t Hash() const
+        {
+            return _hash;
+        }
+
+    private:
+        const char* _name;
+        uint32_t _hash;
+    };
+
+    // Result of calls that reply without a payload, or whose payload is not used. The transport
+    // still reports the status of the reply, the result itself is skipped instead of being parsed
+    // into a VariantContainer. Serializes as null.
+    class NoResult : public WPEFramework::Core::JSON::IElement {
+    public:
+        NoResult() = default;
+        ~NoResult() override = default;
+
+        bool IsSet() const override
+        {
+            return false;
+        }
+        bool IsNull() const override
+        {
+            return true;
+        }
+        void Clear() override
+        {
+        }
+
+        uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+        {
+            static constexpr char Null[] = "null";
+            const uint16_t length = std::min(static_cast<uint16_t>(sizeof(Null) - 1 - offset), maxLength);
+            ::memcpy(stream, &Null[offset], length);
+            offset = ((offset + length) < (sizeof(Null) - 1)) ? (offset + length) : 0;
+            return length;
+        }
+        uint16_t Deserialize(const char[], const uint16_t maxLength, uint32_t& offset, WPEFramework::Core::OptionalType<WPEFramework::Core::JSON::Error>&) override
+        {
+            offset = 0;
+            return maxLength;
+        }
+    };
+
+    // Decoder for calls where only the status of the reply matters, pair it with NoResult
+    struct Discard {
+        template <typename RESULT>
+        void operator()(const RESULT&) const
+        {
+        }
+    };
+
+    namespace Internal {
+
+        inline void SetParameters(JsonObject&)
+        {
+        }
+        template <typename VALUE, typename... PARAMETERS>
+        void SetParameters(JsonObject& jsonParameters, const TCHAR* name, const VALUE& value, const PARAMETERS&... parameters)
+        {
+            WPEFramework::Core::JSON::Variant variant(value);
+            jsonParameters.Set(name, variant);
+            SetParameters(jsonParameters, parameters...);
+        }
+
+        template <typename RESULT, typename DECODER>
+        Firebolt::Error Invoke(Transport<WPEFramework::Core::JSON::IElement>* transport, const Method& method, Latency::Timer& timer, const JsonObject& jsonParameters, DECODER&& decode)
+        {
+            RESULT jsonResult;
+            timer.Encoded(jsonParameters);
+            const Firebolt::Error status = transport->Invoke(method.Name(), jsonParameters, jsonResult);
+            timer.Replied(status, jsonResult);
+            if (status == Firebolt::Error::None) {
+                FIREBOLT_LOG_INFO(Logger::Category::OpenRPC, Logger::Module<Accessor>(), "%s is successfully invoked", method.Name());
+                std::forward<DECODER>(decode)(jsonResult);
+            } else {
+                FIREBOLT_LOG_ERROR(Logger::Category::OpenRPC, Logger::Module<Accessor>(), "Error in invoking %s: %d", method.Name(), status);
+            }
+            return status;
+        }
+
+    } // namespace Internal
+
+    // Invokes method with the parameters given as name, value pairs and, on success, hands the
+    // reply to decode. Timing, tracing, probes and logging of the call are all done here, the
+    // decode time is accounted to the method as well.
+    //
+    //     static constexpr FireboltSDK::Method Version("device.version");
+    //     status = FireboltSDK::InvokeMethod<JsonData_Versions>(Version, [&](JsonData_Versions& jsonResult) { ... });
+    //     status = FireboltSDK::InvokeMethod<FireboltSDK::NoResult>(Ready, FireboltSDK::Discard());
+    template <typename RESULT, typename DECODER, typename... PARAMETERS>
+    Firebolt::Error InvokeMethod(const Method& method, DECODER&& decode, const PARAMETERS&... parameters)
+    {
+        static_assert((sizeof...(PARAMETERS) % 2) == 0, "parameters are name, value pairs");
+
+        // Looked up on every call, the Accessor replaces the transport on reconnect and deletes it on dispose
+        Transport<WPEFramework::Core::JSON::IElement>* transport = Accessor::Instance().GetTransport();
+        if (transport == nullptr) {
+            FIREBOLT_LOG_ERROR(Logger::Category::OpenRPC, Logger::Module<Accessor>(), "Error in getting Transport err = %d", Firebolt::Error::NotConnected);
+            return Firebolt::Error::NotConnected;
+        }
+
+        Latency::Timer timer(method.Name(), method.Hash());
+        JsonObject jsonParameters;
+        Internal::SetParameters(jsonParameters, parameters...);
+        return Internal::Invoke<RESULT>(transport, method, timer, jsonParameters, std::forward<DECODER>(decode));
+    }
+
+    // Same, for parameters that are already in a JsonObject, e.g. parsed back from queued JSON text
+    template <typename RESULT, typename DECODER>
+    Firebolt::Error InvokeMethod(const Method& method, DECODER&& decode, const JsonObject& jsonParameters)
+    {
+        Transport<WPEFramework::Core::JSON::IElement>* transport = Accessor::Instance().GetTransport();
+        if (transport == nullptr) {
+            FIREBOLT_LOG_ERROR(Logger::Category::OpenRPC, Logger::Module<Accessor>(), "Error in getting Transport err = %d", Firebolt::Error::NotConnected);
+            return Firebolt::Error::NotConnected;
+        }
+
+        Latency::Timer timer(method.Name(), method.Hash());
+        return Internal::Invoke<RESULT>(transport, method, timer, jsonParameters, std::forward<DECODER>(decode));
+    }
+
+} // namespace FireboltSDK
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "FireboltSDK.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Compile time minimum log level. Calls below it expand to nothing, arguments included.
+// Release builds keep errors and warnings only, override with -DFIREBOLT_LOG_MIN_LEVEL=<level>.
+#define FIREBOLT_LOG_LEVEL_ERROR 0
+#define FIREBOLT_LOG_LEVEL_WARNING 1
+#define FIREBOLT_LOG_LEVEL_INFO 2
+#define FIREBOLT_LOG_LEVEL_DEBUG 3
+
+#ifndef FIREBOLT_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define FIREBOLT_LOG_MIN_LEVEL FIREBOLT_LOG_LEVEL_WARNING
+#else
+#define FIREBOLT_LOG_MIN_LEVEL FIREBOLT_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+namespace FireboltSDK {
+
+    // Logger backend that keeps the formatting on the calling thread but moves the actual
+    // write to a background thread. Every logging thread formats into its own single
+    // producer ring, so logging takes no locks; records that do not fit are dropped and
+    // counted. Until Start() is called all records go straight to Logger::Log. Once started,
+    // records above the level given to Start() are discarded before anything is formatted.
+    class AsyncLogger {
+    private:
+        static constexpr uint32_t RingSize = 64; // records per thread, power of 2
+        static constexpr uint32_t ModuleSize = 32;
+        static constexpr uint32_t MessageSize = 256;
+        static constexpr uint32_t DrainIntervalMs = 10;
+
+        struct Record {
+            Logger::LogLevel level;
+            Logger::Category category;
+            uint16_t line;
+            const char* file;
+            const char* function;
+            char module[ModuleSize];
+            char message[MessageSize];
+        };
+
+        class Ring {
+        public:
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+            Ring()
+                : _head(0)
+                , _tail(0)
+                , _writing(false)
+                , _detached(false)
+            {
+            }
+            ~Ring() = default;
+
+            // Producer side, the owning thread only
+            Record* Claim()
+            {
+                const uint32_t tail = _tail.load(std::memory_order_relaxed);
+                return ((tail - _head.load(std::memory_order_acquire)) < RingSize) ? &_records[tail & (RingSize - 1)] : nullptr;
+            }
+            void Commit()
+            {
+                _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+            // Brackets a Claim() and Commit(), so Stop() can wait for a record being written
+            void Enter()
+            {
+                _writing.store(true);
+            }
+            void Leave()
+            {
+                _writing.store(false, std::memory_order_release);
+            }
+            bool IsWriting() const
+            {
+                return _writing.load();
+            }
+
+            // Consumer side, the writer thread only
+            const Record* Front() const
+            {
+                const uint32_t head = _head.load(std::memory_order_relaxed);
+                return (head != _tail.load(std::memory_order_acquire)) ? &_records[head & (RingSize - 1)] : nullptr;
+            }
+            void Pop()
+            {
+                _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            void Detach()
+            {
+                _detached.store(true, std::memory_order_release);
+            }
+            bool IsDetached() const
+            {
+                return _detached.load(std::memory_order_acquire);
+            }
+
+        private:
+            Record _records[RingSize];
+            alignas(64) std::atomic<uint32_t> _head;
+            alignas(64) std::atomic<uint32_t> _tail;
+            std::atomic<bool> _writing;
+            std::atomic<bool> _detached;
+        };
+
+        // Hands the thread's ring back to the writer when the thread exits. Shared with the
+        // logger, as a thread may exit after the static logger is destroyed
+        struct RingHolder {
+            std::shared_ptr<Ring> ring;
+            ~RingHolder()
+            {
+                if (ring != nullptr) {
+                    ring->Detach();
+                }
+            }
+        };
+
+    public:
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        static AsyncLogger& Instance()
+        {
+            static AsyncLogger instance;
+            return instance;
+        }
+
+        // level is the runtime level, it is passed on to Logger as well
+        void Start(const Logger::LogLevel level)
+        {
+            Logger::SetLogLevel(level);
+            _level.store(level, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(_adminLock);
+            if (_writer.joinable() == false) {
+                _stopping = false;
+                _writer = std::thread(&AsyncLogger::Writer, this);
+            }
+            _running.store(true);
+        }
+
+        // Writes out everything still queued before returning
+        void Stop()
+        {
+            _running.store(false);
+            {
+                std::lock_guard<std::mutex> lock(_adminLock);
+                _stopping = true;
+            }
+            _wakeup.notify_one();
+            if (_writer.joinable() == true) {
+                _writer.join();
+            }
+            // Records of threads that were still writing when the writer did its last round
+            {
+                std::lock_guard<std::mutex> lock(_ringsLock);
+                for (const std::shared_ptr<Ring>& ring : _rings) {
+                    while (ring->IsWriting() == true) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            Drain();
+        }
+
+        // Checked by the FIREBOLT_LOG_* macros before their arguments are evaluated
+        bool IsEnabled(const Logger::LogLevel level) const
+        {
+            return ((_running.load(std::memory_order_relaxed) == false) || (level <= _level.load(std::memory_order_relaxed)));
+        }
+
+        uint32_t Dropped() const
+        {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+        template <typename... Args>
+        void Log(const Logger::LogLevel level, const Logger::Category category, const std::string& module, const char* file, const char* function, const uint16_t line, const char* format, Args... args)
+        {
+            if (_running.load(std::memory_order_acquire) == false) {
+                Logger::Log(level, category, module, file, function, line, format, args...);
+                return;
+            }
+
+            Ring& ring = LocalRing();
+            ring.Enter();
+            if (_running.load() == false) {
+                ring.Leave();
+                Logger::Log(level, category, module, file, function, line, format, args...);
+                return;
+            }
+            Record* record = ring.Claim();
+            if (record == nullptr) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                record->level = level;
+                record->category = category;
+                record->line = line;
+                record->file = file;
+                record->function = function;
+                snprintf(record->module, sizeof(record->module), "%s", module.c_str());
+                Format(record->message, format, args...);
+                ring.Commit();
+            }
+            ring.Leave();
+        }
+
+    private:
+        AsyncLogger()
+            : _running(false)
+            , _level(Logger::LogLevel::Error)
+            , _dropped(0)
+            , _stopping(false)
+        {
+        }
+        ~AsyncLogger()
+        {
+            Stop();
+        }
+
+        static void Format(char (&message)[MessageSize], const char* format)
+        {
+            snprintf(message, sizeof(message), "%s", format);
+        }
+        template <typename... Args>
+        static void Format(char (&message)[MessageSize], const char* format, Args... args)
+        {
+            snprintf(message, sizeof(message), format, args...);
+        }
+
+        Ring& LocalRing()
+        {
+            static thread_local RingHolder holder;
+            if (holder.ring == nullptr) {
+                holder.ring = std::make_shared<Ring>();
+                std::lock_guard<std::mutex> lock(_ringsLock);
+                _rings.push_back(holder.ring);
+            }
+            return *holder.ring;
+        }
+
+        void Drain()
+        {
+            std::lock_guard<std::mutex> lock(_ringsLock);
+            for (auto ring = _rings.begin(); ring != _rings.end();) {
+                const bool detached = (*ring)->IsDetached();
+                const Record* record;
+                while ((record = (*ring)->Front()) != nullptr) {
+                    Logger::Log(record->level, record->category, record->module, record->file, record->function, record->line, "%s", record->message);
+                    (*ring)->Pop();
+                }
+                // Owner is gone and it was drained after that, nobody can write to it anymore
+                ring = (detached == true) ? _rings.erase(ring) : std::next(ring);
+            }
+        }
+
+        void Writer()
+        {
+            std::unique_lock<std::mutex> lock(_adminLock);
+            while (_stopping == false) {
+                _wakeup.wait_for(lock, std::chrono::milliseconds(DrainIntervalMs), [this]() { return _stopping; });
+                lock.unlock();
+                Drain();
+                lock.lock();
+            }
+        }
+
+    private:
+        std::atomic<bool> _running;
+        std::atomic<Logger::LogLevel> _level;
+        std::atomic<uint32_t> _dropped;
+
+        std::mutex _ringsLock;
+        std::vector<std::shared_ptr<Ring>> _rings;
+
+        std::mutex _adminLock;
+        std::condition_variable _wakeup;
+        std::thread _writer;
+        bool _stopping;
+    };
+
+} // namespace FireboltSDK
+
+#undef FIREBOLT_LOG_ERROR
+#undef FIREBOLT_LOG_WARNING
+#undef FIREBOLT_LOG_INFO
+#undef FIREBOLT_LOG_DEBUG
+
+#define FIREBOLT_ASYNC_LOG(level, category, module, ...)                                                                         \
+    do {                                                                                                                        \
+        if (FireboltSDK::AsyncLogger::Instance().IsEnabled(level) == true) {                                                    \
+            FireboltSDK::AsyncLogger::Instance().Log(level, category, module, __FILE__, __func__, __LINE__, __VA_ARGS__);       \
+        }                                                                                                                       \
+    } while (0)
+
+#define FIREBOLT_LOG_ERROR(category, module, ...) FIREBOLT_ASYNC_LOG(FireboltSDK::Logger::LogLevel::Error, category, module, __VA_ARGS__)
+
+#if FIREBOLT_LOG_MIN_LEVEL >= FIREBOLT_LOG_LEVEL_WARNING
+#define FIREBOLT_LOG_WARNING(category, module, ...) FIREBOLT_ASYNC_LOG(FireboltSDK::Logger::LogLevel::Warning, category, module, __VA_ARGS__)
+#else
+#define FIREBOLT_LOG_WARNING(category, module, ...) do { } while (0)
+#endif
+
+#if FIREBOLT_LOG_MIN_LEVEL >= FIREBOLT_LOG_LEVEL_INFO
+#define FIREBOLT_LOG_INFO(category, module, ...) FIREBOLT_ASYNC_LOG(FireboltSDK::Logger::LogLevel::Info, category, module, __VA_ARGS__)
+#else
+#define FIREBOLT_LOG_INFO(category, module, ...) do { } while (0)
+#endif
+
+#if FIREBOLT_LOG_MIN_LEVEL >= FIREBOLT_LOG_LEVEL_DEBUG
+#define FIREBOLT_LOG_DEBUG(category, module, ...) FIREBOLT_ASYNC_LOG(FireboltSDK::Logger::LogLevel::Debug, category, module, __VA_ARGS__)
+#else
+#define FIREBOLT_LOG_DEBUG(category, module, ...) do { } while (0)
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace FireboltSDK {
+
+    // Whole text as a number, with std::from_chars: locale independent, no allocation and no
+    // errno. Returns false on trailing characters or when the value does not fit.
+    template <typename NUMBER>
+    typename std::enable_if<std::is_integral<NUMBER>::value, bool>::type ParseNumber(const char* begin, const char* end, NUMBER& value)
+    {
+        const std::from_chars_result result = std::from_chars(begin, end, value);
+        return (result.ec == std::errc()) && (result.ptr == end);
+    }
+    template <typename NUMBER>
+    typename std::enable_if<std::is_floating_point<NUMBER>::value, bool>::type ParseNumber(const char* begin, const char* end, NUMBER& value)
+    {
+#ifdef __cpp_lib_to_chars
+        const std::from_chars_result result = std::from_chars(begin, end, value);
+        return (result.ec == std::errc()) && (result.ptr == end);
+#else
+        // Floating point from_chars needs GCC 11, strtod needs a terminated copy and reports
+        // a value out of range, e.g. 1e400, through errno
+        char buffer[64];
+        const size_t length = static_cast<size_t>(end - begin);
+        if (length >= sizeof(buffer)) {
+            return false;
+        }
+        ::memcpy(buffer, begin, length);
+        buffer[length] = '\0';
+        char* last = nullptr;
+        errno = 0;
+        value = static_cast<NUMBER>(::strtod(buffer, &last));
+        return (length != 0) && (last == &buffer[length]) && (errno != ERANGE);
+#endif
+    }
+    template <typename NUMBER>
+    bool ParseNumber(const std::string& text, NUMBER& value)
+    {
+        return ParseNumber(text.data(), text.data() + text.size(), value);
+    }
+
+    // Point in time of a schema "date-time" (RFC 3339), in milliseconds since the epoch. Parse
+    // reads the fixed format YYYY-MM-DDTHH:MM:SS[.fraction](Z|+HH:MM|-HH:MM) in one pass, a
+    // plain YYYY-MM-DD is taken as midnight UTC. Digits past milliseconds are dropped.
+    class Timestamp {
+    public:
+        using TimePoint = std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+        constexpr Timestamp()
+            : _milliseconds(0)
+            , _valid(false)
+        {
+        }
+        explicit constexpr Timestamp(const int64_t milliseconds)
+            : _milliseconds(milliseconds)
+            , _valid(true)
+        {
+        }
+
+        constexpr bool IsValid() const
+        {
+            return _valid;
+        }
+        constexpr int64_t Milliseconds() const
+        {
+            return _milliseconds;
+        }
+        TimePoint Time() const
+        {
+            return TimePoint(std::chrono::milliseconds(_milliseconds));
+        }
+
+        static constexpr bool Parse(const char* text, const size_t length, Timestamp& timestamp)
+        {
+            int32_t year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0, millisecond = 0, offset = 0;
+            if ((length < 10) || (Digits(text, 4, year) == false) || (text[4] != '-') || (Digits(&text[5], 2, month) == false)
+                || (text[7] != '-') || (Digits(&text[8], 2, day) == false)
+                || (month < 1) || (month > 12) || (day < 1) || (day > DaysInMonth(year, month))) {
+                return false;
+            }
+            if (length > 10) {
+                if ((length < 20) || ((text[10] != 'T') && (text[10] != 't') && (text[10] != ' '))
+                    || (Digits(&text[11], 2, hour) == false) || (text[13] != ':') || (Digits(&text[14], 2, minute) == false)
+                    || (text[16] != ':') || (Digits(&text[17], 2, second) == false)
+                    || (hour > 23) || (minute > 59) || (second > 60)) {
+                    return false;
+                }
+                size_t position = 19;
+                if (text[position] == '.') {
+                    const size_t first = ++position;
+                    int32_t scale = 100;
+                    while ((position < length) && (text[position] >= '0') && (text[position] <= '9')) {
+                        millisecond += (text[position] - '0') * scale;
+                        scale /= 10;
+                        ++position;
+                    }
+                    if (position == first) {
+                        return false;
+                    }
+                }
+                if ((position == (length - 1)) && ((text[position] == 'Z') || (text[position] == 'z'))) {
+                    offset = 0;
+                } else {
+                    int32_t offsetHour = 0, offsetMinute = 0;
+                    if ((position != (length - 6)) || ((text[position] != '+') && (text[position] != '-'))
+                        || (Digits(&text[position + 1], 2, offsetHour) == false) || (text[position + 3] != ':')
+                        || (Digits(&text[position + 4], 2, offsetMinute) == false) || (offsetHour > 23) || (offsetMinute > 59)) {
+                        return false;
+                    }
+                    offset = ((offsetHour * 60) + offsetMinute) * ((text[position] == '-') ? -60 : 60);
+                }
+            }
+            const int64_t seconds = (DaysFromCivil(year, month, day) * 86400) + (hour * 3600) + (minute * 60) + second - offset;
+            timestamp = Timestamp((seconds * 1000) + millisecond);
+            return true;
+        }
+        static bool Parse(const std::string& text, Timestamp& timestamp)
+        {
+            return Parse(text.data(), text.size(), timestamp);
+        }
+
+    private:
+        static constexpr bool Digits(const char* text, const uint32_t count, int32_t& value)
+        {
+            value = 0;
+            for (uint32_t index = 0; index < count; ++index) {
+                if ((text[index] < '0') || (text[index] > '9')) {
+                    return false;
+                }
+                value = (value * 10) + (text[index] - '0');
+            }
+            return true;
+        }
+        static constexpr int32_t DaysInMonth(const int32_t year, const int32_t month)
+        {
+            return (month == 2) ? ((((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0))) ? 29 : 28)
+                : (((month == 4) || (month == 6) || (month == 9) || (month == 11)) ? 30 : 31);
+        }
+        // Days since 1970-01-01 of a proleptic Gregorian date
+        static constexpr int64_t DaysFromCivil(int32_t year, const int32_t month, const int32_t day)
+        {
+            year -= (month <= 2) ? 1 : 0;
+            const int64_t era = year / 400;
+            const int64_t yearOfEra = year - (era * 400);
+            const int64_t dayOfYear = (((153 * (month + ((month > 2) ? -3 : 9))) + 2) / 5) + day - 1;
+            const int64_t dayOfEra = (yearOfEra * 365) + (yearOfEra / 4) - (yearOfEra / 100) + dayOfYear;
+            return (era * 146097) + dayOfEra - 719468;
+        }
+
+    private:
+        int64_t _milliseconds;
+        bool _valid;
+    };
+
+} // namespace FireboltSDK
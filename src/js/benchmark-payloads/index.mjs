@@ -0,0 +1,132 @@
+#!/usr/bin/env node
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Collects one example payload per schema type from the OpenRPC and JSON schema sources and
+// writes them as a C++ header, for the JSON benchmarks of the C++ SDK.
+//
+// A type gets its payload from its own `examples`, from a method example that passes or
+// returns it, or from a property of an example of an enclosing type.
+//
+// usage: node index.mjs --openrpc <dir> --schemas <dir> --output <Payloads.h>
+
+import { readdir, readFile, writeFile } from 'fs/promises'
+import path from 'path'
+
+const args = process.argv.slice(2)
+const option = (name, fallback) => {
+    const index = args.indexOf(`--${name}`)
+    return (index >= 0 && index + 1 < args.length) ? args[index + 1] : fallback
+}
+
+const openrpcDir = option('openrpc', './src/openrpc')
+const schemasDir = option('schemas', './src/schemas')
+const output = option('output', './Payloads.h')
+
+const loadDir = async dir => Promise.all((await readdir(dir))
+    .filter(file => file.endsWith('.json'))
+    .sort()
+    .map(async file => JSON.parse((await readFile(path.join(dir, file))).toString())))
+
+const openrpcs = await loadDir(openrpcDir)
+const schemas = await loadDir(schemasDir)
+const schemasById = Object.fromEntries(schemas.filter(schema => schema.$id).map(schema => [schema.$id, schema]))
+
+// Resolves a $ref relative to the document it appears in, returns [name, schema, document]
+const resolve = (ref, document) => {
+    const [base, pointer] = ref.split('#')
+    const target = base ? schemasById[base] : document
+    if (!target || !pointer) {
+        return []
+    }
+    const schema = pointer.split('/').filter(part => part).reduce((node, part) => node && node[part], target)
+    return schema ? [pointer.split('/').pop(), schema, target] : []
+}
+
+const payloads = new Map()
+
+const record = (schema, document, value) => {
+    if (!schema || value === undefined || value === null) {
+        return
+    }
+    if (schema.$ref) {
+        const [name, resolved, target] = resolve(schema.$ref, document)
+        if (!name) {
+            return
+        }
+        if (!payloads.has(name) && typeof value === 'object') {
+            payloads.set(name, value)
+        }
+        record(resolved, target, value)
+    }
+    else if (Array.isArray(value) && schema.items) {
+        value.forEach(item => record(schema.items, document, item))
+    }
+    else if (typeof value === 'object' && schema.properties) {
+        Object.entries(schema.properties).forEach(([key, property]) => record(property, document, value[key]))
+    }
+    if (schema.allOf) {
+        schema.allOf.forEach(branch => record(branch, document, value))
+    }
+}
+
+const recordExamples = (name, schema, document) => {
+    (schema.examples || []).forEach(example => {
+        if (!payloads.has(name) && example !== null && typeof example === 'object') {
+            payloads.set(name, example)
+        }
+        record(schema, document, example)
+    })
+}
+
+openrpcs.forEach(openrpc => {
+    Object.entries(openrpc.components && openrpc.components.schemas || {}).forEach(([name, schema]) => recordExamples(name, schema, openrpc))
+    ;(openrpc.methods || []).forEach(method => (method.examples || []).forEach(example => {
+        (example.params || []).forEach(param => {
+            const definition = (method.params || []).find(p => p.name === param.name)
+            definition && record(definition.schema, openrpc, param.value)
+        })
+        example.result && method.result && record(method.result.schema, openrpc, example.result.value)
+    }))
+})
+schemas.forEach(schema => Object.entries(schema.definitions || {}).forEach(([name, definition]) => recordExamples(name, definition, schema)))
+
+const header = `/*
+ * Generated by src/js/benchmark-payloads from the OpenRPC and schema examples, do not edit.
+ */
+
+#pragma once
+
+namespace FireboltSDK {
+namespace Benchmark {
+
+    struct Payload {
+        const char* type;
+        const char* json;
+    };
+
+    static const Payload Payloads[] = {
+${[...payloads.entries()].sort(([a], [b]) => a.localeCompare(b)).map(([name, value]) => `        { "${name}", R"json(${JSON.stringify(value)})json" },`).join('\n')}
+    };
+
+} // namespace Benchmark
+} // namespace FireboltSDK
+`
+
+await writeFile(output, header)
+console.log(`Wrote ${payloads.size} payloads to ${output}`)
@@ -0,0 +1,161 @@
+#!/usr/bin/env node
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+// Reduces an SDK OpenRPC document to the modules an app uses, so the C++ SDK generated from
+// it carries no code, JSON types or enum tables of the other modules. Kept are the methods
+// and events of the listed modules, the modules they call into, and the component and
+// x-schemas definitions reachable from them.
+//
+// Without modules, from --modules or the FIREBOLT_MODULES environment variable, all of the
+// document is kept.
+//
+// Methods the hand-written C++ templates implement themselves are tagged rpc-only, like ready,
+// signIn and signOut already are in Metrics, so that no second implementation is generated.
+//
+// usage: node index.mjs --input <sdk-open-rpc.json> --output <file> [--modules device,lifecycle]
+//
+// The cpp:compile scripts of the SDKs run it, e.g. FIREBOLT_MODULES=device,lifecycle npm run cpp
+
+import { mkdir, readFile, writeFile } from 'fs/promises'
+import path from 'path'
+
+const args = process.argv.slice(2)
+const option = (name, fallback) => {
+    const index = args.indexOf(`--${name}`)
+    return (index >= 0 && index + 1 < args.length) ? args[index + 1] : fallback
+}
+
+const input = option('input')
+const output = option('output')
+const modules = new Set(option('modules', process.env.FIREBOLT_MODULES || '')
+    .split(',').map(module => module.trim().toLowerCase()).filter(module => module))
+
+if (!input || !output) {
+    console.error('usage: node index.mjs --input <sdk-open-rpc.json> --output <file> [--modules device,lifecycle]')
+    process.exit(1)
+}
+
+const openrpc = JSON.parse((await readFile(input)).toString())
+await mkdir(path.dirname(output), { recursive: true })
+
+const moduleOf = method => method.name.split('.')[0].toLowerCase()
+const hasTag = (method, name) => (method.tags || []).some(tag => tag.name === name)
+
+// Methods of the hand-written C++ templates, e.g. Metrics queues these in asynchronous mode
+const templateMethods = {
+    metrics: ['startContent', 'stopContent', 'page', 'action']
+}
+openrpc.methods = openrpc.methods.map(method => (templateMethods[moduleOf(method)] || []).includes(method.name.split('.').pop()) && !hasTag(method, 'rpc-only')
+    ? Object.assign({}, method, { tags: [...(method.tags || []), { name: 'rpc-only' }] })
+    : method)
+
+if (modules.size === 0) {
+    await writeFile(output, JSON.stringify(openrpc, null, 2))
+    console.log(`Kept all ${openrpc.methods.length} methods in ${output}`)
+    process.exit(0)
+}
+
+const callsMetrics = method => hasTag(method, 'calls-metrics')
+
+// Calls the hand-written C++ templates make into other modules
+const templateCalls = {
+    lifecycle: ['metrics']
+}
+
+const known = new Set(openrpc.methods.map(moduleOf))
+const unknown = [...modules].filter(module => !known.has(module))
+if (unknown.length) {
+    console.error(`Unknown modules: ${unknown.join(', ')}, available: ${[...known].sort().join(', ')}`)
+    process.exit(1)
+}
+
+;[...modules].forEach(module => (templateCalls[module] || []).forEach(callee => known.has(callee) && modules.add(callee)))
+if (known.has('metrics') && openrpc.methods.some(method => modules.has(moduleOf(method)) && callsMetrics(method))) {
+    modules.add('metrics')
+}
+
+const methods = openrpc.methods.filter(method => modules.has(moduleOf(method)))
+
+// Reachable definitions: component schema names, and x-schemas name -> definition names
+const xSchemas = openrpc['x-schemas'] || {}
+const xSchemaOf = uri => Object.keys(xSchemas).find(name => xSchemas[name].uri === uri || xSchemas[name].$id === uri)
+const components = new Set()
+const definitions = new Map(Object.keys(xSchemas).map(name => [name, new Set()]))
+const untrimmed = new Set()
+
+// Returns [x-schemas name or null for the components, definition name, definition]
+const resolve = (ref, scope) => {
+    const [uri, pointer = ''] = ref.split('#')
+    const parts = pointer.split('/').filter(part => part)
+    if (!uri && parts[0] === 'components' && parts[1] === 'schemas') {
+        return [null, parts[2], (openrpc.components.schemas || {})[parts[2]]]
+    }
+    if (!uri && parts[0] === 'x-schemas') {
+        return [parts[1], parts[2], (xSchemas[parts[1]] || {})[parts[2]] || ((xSchemas[parts[1]] || {}).definitions || {})[parts[2]]]
+    }
+    const name = uri ? xSchemaOf(uri) : scope
+    if (name && parts[0] === 'definitions') {
+        return [name, parts[1], (xSchemas[name].definitions || {})[parts[1]]]
+    }
+    return []
+}
+
+const walk = (node, scope) => {
+    if (Array.isArray(node)) {
+        node.forEach(child => walk(child, scope))
+    }
+    else if (node && typeof node === 'object') {
+        if (typeof node.$ref === 'string') {
+            const [name, definition, schema] = resolve(node.$ref, scope)
+            if (!schema) {
+                // Keeps that x-schema whole rather than risk a dangling reference
+                const [uri] = node.$ref.split('#')
+                const target = uri ? xSchemaOf(uri) : scope
+                target && untrimmed.add(target)
+                console.warn(`Unresolved ${node.$ref}, not trimmed`)
+            }
+            else if (name === null ? !components.has(definition) : !definitions.get(name).has(definition)) {
+                name === null ? components.add(definition) : definitions.get(name).add(definition)
+                walk(schema, name)
+            }
+        }
+        Object.values(node).forEach(child => walk(child, scope))
+    }
+}
+walk(methods, null)
+
+const pick = (object, names) => Object.fromEntries(Object.entries(object || {}).filter(([name]) => names.has(name)))
+// x-schemas keep their types under definitions, or next to uri and title in older documents
+const trim = (schema, names) => schema.definitions
+    ? Object.assign({}, schema, { definitions: pick(schema.definitions, names) })
+    : Object.fromEntries(Object.entries(schema).filter(([name, value]) => names.has(name) || typeof value !== 'object'))
+
+const sliced = Object.assign({}, openrpc, { methods })
+if (openrpc.components) {
+    sliced.components = Object.assign({}, openrpc.components, { schemas: pick(openrpc.components.schemas, components) })
+}
+if (openrpc['x-schemas']) {
+    sliced['x-schemas'] = Object.fromEntries(Object.entries(xSchemas)
+        .filter(([name]) => untrimmed.has(name) || definitions.get(name).size > 0)
+        .map(([name, schema]) => [name, untrimmed.has(name) ? schema : trim(schema, definitions.get(name))]))
+}
+
+await writeFile(output, JSON.stringify(sliced, null, 2))
+console.log(`Kept ${methods.length} of ${openrpc.methods.length} methods (${[...modules].sort().join(', ')}), ${components.size} of ${Object.keys(openrpc.components && openrpc.components.schemas || {}).length} component schemas and ${Object.keys(sliced['x-schemas'] || {}).length} of ${Object.keys(xSchemas).length} x-schemas in ${output}`)
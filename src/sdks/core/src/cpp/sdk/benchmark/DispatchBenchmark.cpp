@@ -0,0 +1,76 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Cost of a module call through the accessor, through the cached interface (virtual) and
+// through the final implementation (FireboltSDK::Direct). Lifecycle.state is answered
+// locally, so the numbers are the dispatch itself, no transport is involved.
+
+#include "firebolt.h"
+#include "lifecycle_impl.h"
+#include "Direct.h"
+#include <benchmark/benchmark.h>
+
+namespace FireboltSDK {
+namespace Benchmark {
+
+    static void LifecycleStateAccessor(benchmark::State& state)
+    {
+        Firebolt::Error error;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Firebolt::IFireboltAccessor::Instance().LifecycleInterface().state(&error));
+        }
+    }
+
+    static void LifecycleStateVirtual(benchmark::State& state)
+    {
+        Firebolt::Lifecycle::ILifecycle& lifecycle = Firebolt::IFireboltAccessor::Instance().LifecycleInterface();
+        benchmark::DoNotOptimize(&lifecycle);
+        Firebolt::Error error;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(lifecycle.state(&error));
+        }
+    }
+
+    static void LifecycleStateDirect(benchmark::State& state)
+    {
+        Firebolt::Lifecycle::LifecycleImpl& lifecycle = FireboltSDK::Direct<Firebolt::Lifecycle::LifecycleImpl>(Firebolt::IFireboltAccessor::Instance().LifecycleInterface());
+        Firebolt::Error error;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(lifecycle.state(&error));
+        }
+    }
+
+} // namespace Benchmark
+} // namespace FireboltSDK
+
+BENCHMARK(FireboltSDK::Benchmark::LifecycleStateAccessor);
+BENCHMARK(FireboltSDK::Benchmark::LifecycleStateVirtual);
+BENCHMARK(FireboltSDK::Benchmark::LifecycleStateDirect);
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv) == true) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    Firebolt::IFireboltAccessor::Instance().Dispose();
+    return 0;
+}
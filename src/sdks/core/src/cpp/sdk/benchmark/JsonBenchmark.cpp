@@ -0,0 +1,221 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "Module.h"
+#include "Parse.h"
+#include "Payloads.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <string>
+#include <vector>
+
+// Every allocation of the benchmark thread is counted, so each benchmark can report
+// how many allocations one encode or decode of the payload costs. Kept out of line, the
+// compiler would otherwise pair the inlined free() with new expressions and warn.
+static thread_local uint64_t allocations = 0;
+static thread_local uint64_t allocatedBytes = 0;
+
+__attribute__((noinline)) void* operator new(std::size_t size)
+{
+    ++allocations;
+    allocatedBytes += size;
+    void* memory = malloc(size != 0 ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+__attribute__((noinline)) void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+__attribute__((noinline)) void operator delete(void* memory, std::size_t) noexcept
+{
+    free(memory);
+}
+
+namespace FireboltSDK {
+namespace Benchmark {
+
+    class AllocationCounter {
+    public:
+        AllocationCounter(const AllocationCounter&) = delete;
+        AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+        AllocationCounter()
+            : _allocations(allocations)
+            , _allocatedBytes(allocatedBytes)
+        {
+        }
+        ~AllocationCounter() = default;
+
+        void Report(benchmark::State& state) const
+        {
+            state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations - _allocations), benchmark::Counter::kAvgIterations);
+            state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(allocatedBytes - _allocatedBytes), benchmark::Counter::kAvgIterations);
+        }
+
+    private:
+        const uint64_t _allocations;
+        const uint64_t _allocatedBytes;
+    };
+
+    // Payloads are decoded into a Variant, which builds the same Core::JSON element tree
+    // as the generated JsonData types do and goes through the same tokenizer.
+    static void FromJson(benchmark::State& state, const char* json)
+    {
+        const string text(json);
+        AllocationCounter counter;
+        for (auto _ : state) {
+            WPEFramework::Core::JSON::Variant element;
+            element.FromString(text);
+            benchmark::DoNotOptimize(element);
+        }
+        counter.Report(state);
+        state.SetBytesProcessed(state.iterations() * text.size());
+    }
+
+    static void ToJson(benchmark::State& state, const char* json)
+    {
+        WPEFramework::Core::JSON::Variant element;
+        element.FromString(json);
+        size_t size = 0;
+        AllocationCounter counter;
+        for (auto _ : state) {
+            string text;
+            element.ToString(text);
+            size = text.size();
+            benchmark::DoNotOptimize(text);
+        }
+        counter.Report(state);
+        state.SetBytesProcessed(state.iterations() * size);
+    }
+
+    // Numeric and date-time fields of a WayToWatch array, as the decoded strings the app reads
+    struct WayToWatchFields {
+        const char* price;
+        const char* expires;
+        const char* entitledExpires;
+    };
+    static const WayToWatchFields WaysToWatch[] = {
+        { "3.99", "2026-01-01T00:00:00Z", "2025-12-01T00:00:00Z" },
+        { "14.99", "2026-06-30T23:59:59.999Z", "2026-06-30T23:59:59.999Z" },
+        { "0", "2025-11-15T08:30:00+01:00", "2025-11-01T00:00:00-05:00" },
+        { "5.49", "2027-03-10T12:00:00.5Z", "2026-03-10T12:00:00Z" },
+        { "19.99", "2026-02-28T18:45:10Z", "2026-02-28T18:45:10.250+00:00" },
+        { "1.99", "2025-12-24T00:00:00Z", "2025-12-24T00:00:00Z" },
+        { "9.99", "2026-09-01T06:00:00-07:00", "2026-08-01T06:00:00-07:00" },
+        { "24.99", "2028-01-01T00:00:00Z", "2027-01-01T00:00:00Z" },
+    };
+    static constexpr size_t WayToWatchCount = sizeof(WaysToWatch) / sizeof(WaysToWatch[0]);
+
+    static std::vector<std::string> WayToWatchArray()
+    {
+        std::vector<std::string> fields;
+        for (const WayToWatchFields& entry : WaysToWatch) {
+            fields.emplace_back(entry.price);
+            fields.emplace_back(entry.expires);
+            fields.emplace_back(entry.entitledExpires);
+        }
+        return fields;
+    }
+
+    static std::string WayToWatchJson()
+    {
+        std::string json = "[";
+        for (const WayToWatchFields& entry : WaysToWatch) {
+            json += ((&entry != &WaysToWatch[0]) ? ",{" : "{");
+            json += R"("identifiers":{"assetId":"asset-1","entityId":"entity-1"},"entitled":true,"offeringType":"rent","hasAds":false,)";
+            json += R"("price":)" + std::string(entry.price) + R"(,"expires":")" + entry.expires + R"(","entitledExpires":")" + entry.entitledExpires + "\",";
+            json += R"("videoQuality":["HD","UHD"],"audioProfile":["stereo","dolbyAtmos"],"audioLanguages":["en","es"],"closedCaptions":["en"],"subtitles":["es"]})";
+        }
+        return json + "]";
+    }
+
+    // The app reparsing the strings: strtod and strptime/timegm, offsets and fractions ignored
+    static void WayToWatchReparse(benchmark::State& state)
+    {
+        const std::vector<std::string> fields = WayToWatchArray();
+        AllocationCounter counter;
+        for (auto _ : state) {
+            for (size_t index = 0; index < fields.size(); index += 3) {
+                double price = strtod(fields[index].c_str(), nullptr);
+                struct tm time = {};
+                strptime(fields[index + 1].c_str(), "%Y-%m-%dT%H:%M:%S", &time);
+                time_t expires = timegm(&time);
+                time = {};
+                strptime(fields[index + 2].c_str(), "%Y-%m-%dT%H:%M:%S", &time);
+                time_t entitledExpires = timegm(&time);
+                benchmark::DoNotOptimize(price);
+                benchmark::DoNotOptimize(expires);
+                benchmark::DoNotOptimize(entitledExpires);
+            }
+        }
+        counter.Report(state);
+        state.SetItemsProcessed(state.iterations() * WayToWatchCount);
+    }
+
+    // The same fields through ParseNumber (from_chars) and the fixed format Timestamp parser
+    static void WayToWatchParse(benchmark::State& state)
+    {
+        const std::vector<std::string> fields = WayToWatchArray();
+        AllocationCounter counter;
+        for (auto _ : state) {
+            for (size_t index = 0; index < fields.size(); index += 3) {
+                double price = 0;
+                ParseNumber(fields[index], price);
+                Timestamp expires;
+                Timestamp::Parse(fields[index + 1], expires);
+                Timestamp entitledExpires;
+                Timestamp::Parse(fields[index + 2], entitledExpires);
+                benchmark::DoNotOptimize(price);
+                benchmark::DoNotOptimize(expires);
+                benchmark::DoNotOptimize(entitledExpires);
+            }
+        }
+        counter.Report(state);
+        state.SetItemsProcessed(state.iterations() * WayToWatchCount);
+    }
+
+} // namespace Benchmark
+} // namespace FireboltSDK
+
+int main(int argc, char** argv)
+{
+    for (const FireboltSDK::Benchmark::Payload& payload : FireboltSDK::Benchmark::Payloads) {
+        benchmark::RegisterBenchmark((string("FromJson/") + payload.type).c_str(), FireboltSDK::Benchmark::FromJson, payload.json);
+        benchmark::RegisterBenchmark((string("ToJson/") + payload.type).c_str(), FireboltSDK::Benchmark::ToJson, payload.json);
+    }
+
+    static const string wayToWatchJson = FireboltSDK::Benchmark::WayToWatchJson();
+    benchmark::RegisterBenchmark("FromJson/WayToWatch[]", FireboltSDK::Benchmark::FromJson, wayToWatchJson.c_str());
+    benchmark::RegisterBenchmark("WayToWatch[]/Reparse", FireboltSDK::Benchmark::WayToWatchReparse);
+    benchmark::RegisterBenchmark("WayToWatch[]/Parse", FireboltSDK::Benchmark::WayToWatchParse);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv) == true) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#!/bin/bash
+usage()
+{
+   echo "options:"
+   echo "    -t benchmark path"
+   echo "    -s sysroot path"
+   echo "    -f firebolt path"
+   echo "    -i generated <module>_impl.h path, builds FireboltDispatchBenchmark"
+   echo "    -c clear build"
+   echo "    -h : help"
+   echo
+   echo "usage: "
+   echo "    ./build.sh -t benchmarkpath -c -f fireboltpath -s sysrootpath"
+}
+
+BenchmarkPath="."
+FireboltPath=${FIREBOLT_PATH}
+SysrootPath=${SYSROOT_PATH}
+ImplPath=""
+ClearBuild="N"
+while getopts t:s:f:i:ch flag
+do
+    case "${flag}" in
+        t) BenchmarkPath="${OPTARG}";;
+        s) SysrootPath="${OPTARG}";;
+        f) FireboltPath="${OPTARG}";;
+        i) ImplPath="${OPTARG}";;
+        c) ClearBuild="Y";;
+        h) usage && exit 1;;
+    esac
+done
+
+if [ "${ClearBuild}" == "Y" ];
+then
+    rm -rf ${BenchmarkPath}/build
+fi
+
+echo "BenchmarkPath"
+echo "${BenchmarkPath}"
+echo "FireboltPath"
+echo ${FireboltPath}
+cmake -B${BenchmarkPath}/build -S${BenchmarkPath} -DSYSROOT_PATH=${SysrootPath} -DFIREBOLT_PATH=${FireboltPath} -DFIREBOLT_IMPL_PATH=${ImplPath}
+cmake --build ${BenchmarkPath}/build
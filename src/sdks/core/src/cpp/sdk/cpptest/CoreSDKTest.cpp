@@ -21,6 +21,7 @@
 #include <stdexcept>
 #include <string>
 #include "CoreSDKTest.h"
+#include "Instrumentation/Latency.h"
 
 
 using namespace std;
@@ -113,27 +114,38 @@ void CoreSDKTest::GetAccountUid()
     }
 }
 
-template<typename T>
-using EnumMap = std::unordered_map<T, string>;
+// Constant initialized, so that the tools linking this file allocate nothing before main
 template <typename T>
-inline const string& ConvertFromEnum(EnumMap<T> enumMap, T type)
-{
-    return enumMap[type];
+struct EnumName {
+    T value;
+    const char* name;
+};
+template <typename T, size_t N>
+using EnumMap = EnumName<T>[N];
+template <typename T, size_t N>
+inline const char* ConvertFromEnum(const EnumMap<T, N>& enumMap, T type)
+{
+    for (const EnumName<T>& element : enumMap) {
+        if (element.value == type) {
+            return element.name;
+        }
+    }
+    return "";
 }
-template <typename T>
-inline const T ConvertToEnum(EnumMap<T> enumMap, const string& str)
+template <typename T, size_t N>
+inline T ConvertToEnum(const EnumMap<T, N>& enumMap, const string& str)
 {
-     T value;
-     for (auto element: enumMap) {
-          if (element.second == str) {
-              value = element.first;
-              break;
-          }
-     }
-     return value;
+    T value {};
+    for (const EnumName<T>& element : enumMap) {
+        if (str == element.name) {
+            value = element.value;
+            break;
+        }
+    }
+    return value;
 }
 
-EnumMap<Firebolt::Advertising::SkipRestriction> skipRestrictionMap = {
+constexpr EnumName<Firebolt::Advertising::SkipRestriction> skipRestrictionMap[] = {
     { Firebolt::Advertising::SkipRestriction::NONE, "none" },
     { Firebolt::Advertising::SkipRestriction::ADS_UNWATCHED, "adsUnwatched" },
     { Firebolt::Advertising::SkipRestriction::ADS_ALL, "adsAll" },
@@ -714,7 +726,7 @@ void CoreSDKTest::LifecycleClose()
     }
 }
 
-EnumMap<Firebolt::Lifecycle::LifecycleState> lifecycleStateMap = {
+constexpr EnumName<Firebolt::Lifecycle::LifecycleState> lifecycleStateMap[] = {
     { Firebolt::Lifecycle::LifecycleState::INITIALIZING, "initializing" },
     { Firebolt::Lifecycle::LifecycleState::INACTIVE, "inactive" },
     { Firebolt::Lifecycle::LifecycleState::FOREGROUND, "foreground" },
@@ -723,7 +735,7 @@ EnumMap<Firebolt::Lifecycle::LifecycleState> lifecycleStateMap = {
     { Firebolt::Lifecycle::LifecycleState::SUSPENDED, "suspended" }
 };
 
-EnumMap<Firebolt::Lifecycle::LifecycleEventSource> lifecycleEventSourceMap = {
+constexpr EnumName<Firebolt::Lifecycle::LifecycleEventSource> lifecycleEventSourceMap[] = {
     { Firebolt::Lifecycle::LifecycleEventSource::VOICE, "voice" },
     { Firebolt::Lifecycle::LifecycleEventSource::REMOTE, "remote" }
 };
@@ -753,15 +765,31 @@ void CoreSDKTest::LifecycleFinished()
 void CoreSDKTest::LifecycleState()
 {
    Firebolt::Error error = Firebolt::Error::None;
-   const std::string state = Firebolt::IFireboltAccessor::Instance().LifecycleInterface().state(&error);
+   const Firebolt::Lifecycle::LifecycleState state = Firebolt::IFireboltAccessor::Instance().LifecycleInterface().state(&error);
 
     if (error == Firebolt::Error::None) {
-        cout << "State of the App = " << state.c_str() << endl;
+        cout << "State of the App = " << ConvertFromEnum<Firebolt::Lifecycle::LifecycleState>(lifecycleStateMap, state) << endl;
     } else {
         cout << "State of the App throws an error = " << static_cast<int>(error) << endl;
     }
 }
 
+void CoreSDKTest::LifecycleWaitForState()
+{
+    Firebolt::Error error = Firebolt::Error::None;
+    Firebolt::Lifecycle::ILifecycle& lifecycle = Firebolt::IFireboltAccessor::Instance().LifecycleInterface();
+    const Firebolt::Lifecycle::LifecycleState state = lifecycle.state(&error);
+
+    // Waiting for the current state has to return straight away
+    bool reached = lifecycle.waitForState(state, 1000, &error);
+    if (reached == true && error == Firebolt::Error::None) {
+        cout << "Lifecycle waitForState " << ConvertFromEnum<Firebolt::Lifecycle::LifecycleState>(lifecycleStateMap, state) << " is success" << endl;
+    } else {
+        std::string errorMessage = "Error: " + std::to_string(static_cast<int>(error));
+        throw std::runtime_error("LifecycleWaitForState failed. " + errorMessage);
+    }
+}
+
 void CoreSDKTest::OnBackgroundNotification::onBackground( const Firebolt::Lifecycle::LifecycleEvent& lifecycleEvent)
 {
     cout <<"onBackground event is triggered" << endl;
@@ -892,7 +920,7 @@ void CoreSDKTest::GetAuthenticationToken()
     }
 }
 
-EnumMap<Firebolt::Capabilities::DenyReason> denyReasonMap = {
+constexpr EnumName<Firebolt::Capabilities::DenyReason> denyReasonMap[] = {
     { Firebolt::Capabilities::DenyReason::UNPERMITTED, "unpermitted" },
     { Firebolt::Capabilities::DenyReason::UNSUPPORTED, "unsupported" },
     { Firebolt::Capabilities::DenyReason::DISABLED, "disabled" },
@@ -1183,7 +1211,7 @@ void CoreSDKTest::UnsubscribeSecondScreenFriendlyNameChanged()
     }
 }
 
-EnumMap<Firebolt::SecondScreen::SecondScreenEventType> secondScreenEventTypeMap = {
+constexpr EnumName<Firebolt::SecondScreen::SecondScreenEventType> secondScreenEventTypeMap[] = {
     { Firebolt::SecondScreen::SecondScreenEventType::DIAL, "dial" }
 };
 
@@ -1676,4 +1704,17 @@ void CoreSDKTest::OnNavigateToEntityIntentNotification::onNavigateTo(const Fireb
 void CoreSDKTest::OnNavigateToTuneIntentNotification::onNavigateTo(const Firebolt::Intents::TuneIntent& intent)
 {
     cout << "onNavigateTo for action : " << intent.action << endl;
-}
\ No newline at end of file
+}
+
+void CoreSDKTest::LatencySnapshot()
+{
+    const std::vector<FireboltSDK::Latency::MethodLatency> snapshot = FireboltSDK::Latency::Instance().Snapshot();
+    if (snapshot.empty() == true) {
+        throw std::runtime_error("LatencySnapshot failed. No method latency recorded");
+    }
+    cout << "Method latency in us (invoke count/p50/p90/p99/max, decode p99):" << endl;
+    for (const FireboltSDK::Latency::MethodLatency& method : snapshot) {
+        cout << "\t" << method.method << ": " << method.invoke.count << "/" << method.invoke.p50 << "/" << method.invoke.p90
+             << "/" << method.invoke.p99 << "/" << method.invoke.max << ", " << method.decode.p99 << endl;
+    }
+}
@@ -135,6 +135,7 @@ public:
     static void LifecycleFinished();
     static void LifecycleReady();
     static void LifecycleState();
+    static void LifecycleWaitForState();
     static void SubscribeLifecycleBackgroundNotification();
     static void UnsubscribeLifecycleBackgroundNotification();
     static void SubscribeLifecycleForegroundNotification();
@@ -185,6 +186,8 @@ public:
 
     static void ParametersInitialization();
 
+    static void LatencySnapshot();
+
     static bool WaitOnConnectionReady();
 
 private:
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// firebolt-eventstorm: subscribes hundreds of listeners to Device, Accessibility, Lifecycle,
+// Localization and Content events and has the mock server (src/cpp/mock-server) emit them
+// at doubling rates. Every step reports the callbacks per second, the latency from the
+// server send to the listener callback, and the callbacks that never arrived.
+//
+//   firebolt-mock-server &
+//   ./firebolt-eventstorm -l 100 -r 50 -x 6400 -s 3
+
+#include <getopt.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CoreSDKTest.h"
+#include "FireboltSDK.h"
+#include "Instrumentation/Latency.h"
+
+using namespace std;
+
+namespace {
+
+    struct StormEvent {
+        const char* name;
+        bool prioritized; // subscribed through Event::Prioritize, like the Lifecycle module does
+    };
+
+    // Object payloads, so the mock server can stamp them with the send time
+    const StormEvent Events[] = {
+        { "device.onAudioChanged", false },
+        { "device.onHdrChanged", false },
+        { "device.onNetworkChanged", false },
+        { "accessibility.onClosedCaptionsSettingsChanged", false },
+        { "accessibility.onVoiceGuidanceSettingsChanged", false },
+        { "lifecycle.onForeground", true },
+        { "lifecycle.onBackground", true },
+        { "content.onUserInterest", false },
+        // String payload, counted but not timed
+        { "localization.onLocaleChanged", false },
+    };
+    constexpr uint32_t EventCount = sizeof(Events) / sizeof(Events[0]);
+
+    // Drops below this share of the expected callbacks still count as sustained
+    constexpr double DropTolerance = 0.001;
+    constexpr uint32_t DrainMs = 500;
+
+    std::atomic<uint64_t> received { 0 };
+    std::atomic<FireboltSDK::LatencyHistogram*> latency { nullptr };
+
+    struct Listener {
+        uint32_t event;
+    };
+
+    void OnEvent(void*, const void*, void* jsonResponse)
+    {
+        WPEFramework::Core::ProxyType<JsonObject>& response = *(reinterpret_cast<WPEFramework::Core::ProxyType<JsonObject>*>(jsonResponse));
+        received.fetch_add(1, memory_order_relaxed);
+        if ((response.IsValid() == true) && (response->HasLabel(_T("sentUs")) == true)) {
+            const uint64_t now = FireboltSDK::Trace::Now() / 1000;
+            const uint64_t sent = static_cast<uint64_t>(response->Get(_T("sentUs")).Number());
+            FireboltSDK::LatencyHistogram* histogram = latency.load(memory_order_acquire);
+            if ((histogram != nullptr) && (now >= sent)) {
+                histogram->Record(now - sent);
+            }
+        }
+        response.Release();
+    }
+
+    Firebolt::Error Control(const string& method, const string& parameters, JsonObject& result)
+    {
+        FireboltSDK::Transport<WPEFramework::Core::JSON::IElement>* transport = FireboltSDK::Accessor::Instance().GetTransport();
+        if (transport == nullptr) {
+            return Firebolt::Error::NotConnected;
+        }
+        JsonObject jsonParameters;
+        jsonParameters.FromString(parameters);
+        return transport->Invoke(method, jsonParameters, result);
+    }
+
+    uint64_t EmittedEvents()
+    {
+        JsonObject stats;
+        return (Control("mock.stats", "{}", stats) == Firebolt::Error::None) ? static_cast<uint64_t>(stats.Get(_T("events")).Number()) : 0;
+    }
+
+    bool SetRate(const uint32_t perSecond)
+    {
+        JsonObject result;
+        return Control("mock.setEventRate", "{\"perSecond\":" + to_string(perSecond) + ",\"stamp\":true}", result) == Firebolt::Error::None;
+    }
+
+    void Usage(const char* name)
+    {
+        cout << name << " [-u ws://ip:port] [-l listeners per event] [-r first rate] [-x last rate] [-s seconds per step]" << endl;
+        cout << "  rates are events per second for each of the " << EventCount << " events, doubled every step" << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    string url = "ws://127.0.0.1:9998";
+    uint32_t listenersPerEvent = 100;
+    uint32_t firstRate = 50;
+    uint32_t lastRate = 6400;
+    uint32_t stepSeconds = 3;
+
+    int c;
+    while ((c = getopt(argc, argv, "u:l:r:x:s:h")) != -1) {
+        switch (c) {
+        case 'u':
+            url = optarg;
+            break;
+        case 'l':
+            listenersPerEvent = max(1, atoi(optarg));
+            break;
+        case 'r':
+            firstRate = max(1, atoi(optarg));
+            break;
+        case 'x':
+            lastRate = max(1, atoi(optarg));
+            break;
+        case 's':
+            stepSeconds = max(1, atoi(optarg));
+            break;
+        default:
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    CoreSDKTest::CreateFireboltInstance(url);
+    if (CoreSDKTest::WaitOnConnectionReady() == false) {
+        cout << "Event storm not able to connect with server..." << endl;
+        return 1;
+    }
+    if (SetRate(0) == false) {
+        cout << "Server does not answer mock.setEventRate, start firebolt-mock-server" << endl;
+        return 1;
+    }
+
+    // Every listener is its own callback registration for the event
+    const uint32_t listenerCount = EventCount * listenersPerEvent;
+    unique_ptr<Listener[]> listeners(new Listener[listenerCount]);
+    const auto subscribeStart = chrono::steady_clock::now();
+    for (uint32_t index = 0; index < listenerCount; ++index) {
+        Listener& listener = listeners[index];
+        listener.event = index % EventCount;
+        const StormEvent& event = Events[listener.event];
+        JsonObject jsonParameters;
+        const Firebolt::Error status = (event.prioritized == true)
+            ? FireboltSDK::Event::Instance().Prioritize<JsonObject>(event.name, jsonParameters, OnEvent, reinterpret_cast<void*>(&listener), nullptr)
+            : FireboltSDK::Event::Instance().Subscribe<JsonObject>(event.name, jsonParameters, OnEvent, reinterpret_cast<void*>(&listener), nullptr);
+        if (status != Firebolt::Error::None) {
+            cout << "Subscribing to " << event.name << " failed: " << static_cast<int>(status) << endl;
+            return 1;
+        }
+    }
+    cout << listenerCount << " listeners on " << EventCount << " events subscribed in "
+         << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - subscribeStart).count() << " ms" << endl << endl;
+
+    cout << right << setw(8) << "rate" << setw(12) << "events/s" << setw(12) << "callbacks/s" << setw(10) << "dropped"
+         << setw(10) << "p50 us" << setw(10) << "p90 us" << setw(10) << "p99 us" << setw(10) << "max us" << endl;
+
+    // Histograms stay around until the end, late callbacks of a step may still record into them
+    vector<unique_ptr<FireboltSDK::LatencyHistogram>> histograms;
+    uint32_t sustained = 0;
+    double sustainedCallbacks = 0;
+    for (uint32_t rate = firstRate; rate <= lastRate; rate *= 2) {
+        histograms.emplace_back(new FireboltSDK::LatencyHistogram());
+        const FireboltSDK::LatencyHistogram& histogram = *histograms.back();
+        latency.store(histograms.back().get(), memory_order_release);
+        const uint64_t emittedBefore = EmittedEvents();
+        const uint64_t receivedBefore = received.load(memory_order_relaxed);
+
+        const auto start = chrono::steady_clock::now();
+        SetRate(rate);
+        sleep(stepSeconds);
+        SetRate(0);
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        usleep(DrainMs * 1000);
+
+        const uint64_t emitted = EmittedEvents() - emittedBefore;
+        const uint64_t delivered = received.load(memory_order_relaxed) - receivedBefore;
+        const uint64_t expected = emitted * listenersPerEvent;
+        const uint64_t dropped = (expected > delivered) ? (expected - delivered) : 0;
+        latency.store(nullptr, memory_order_release);
+        const FireboltSDK::LatencyHistogram::Summary summary = histogram.Summarize();
+
+        cout << setw(8) << rate << setw(12) << fixed << setprecision(0) << (emitted / elapsed) << setw(12) << (delivered / elapsed)
+             << setw(10) << dropped << setw(10) << summary.p50 << setw(10) << summary.p90 << setw(10) << summary.p99 << setw(10) << summary.max << endl;
+
+        if (dropped > (expected * DropTolerance)) {
+            break;
+        }
+        sustained = rate;
+        sustainedCallbacks = delivered / elapsed;
+    }
+
+    cout << endl;
+    if (sustained > 0) {
+        cout << "Max sustained: " << sustained << " events/s per event, " << fixed << setprecision(0)
+             << (sustained * EventCount) << " events/s, " << sustainedCallbacks << " callbacks/s" << endl;
+    } else {
+        cout << "Not even the first rate was sustained" << endl;
+    }
+
+    for (uint32_t index = 0; index < listenerCount; ++index) {
+        FireboltSDK::Event::Instance().Unsubscribe(Events[listeners[index].event].name, reinterpret_cast<void*>(&listeners[index]));
+    }
+    CoreSDKTest::DestroyFireboltInstance();
+
+    return 0;
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// firebolt-loadgen: N threads issuing a weighted mix of SDK calls for a fixed duration,
+// reporting throughput, per call latency percentiles, CPU usage and RSS.
+//
+//   ./firebolt-loadgen -u ws://127.0.0.1:9998 -n 8 -d 30 -m device.name:4,discovery.policy:1
+
+#include <getopt.h>
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CoreSDKTest.h"
+#include "Instrumentation/Latency.h"
+#include "Logger/AsyncLogger.h"
+
+using namespace std;
+
+namespace {
+
+    // One listener per thread, so subscribe/unsubscribe pairs of the threads do not interfere
+    class NameChangedListener : public Firebolt::Device::IDevice::IOnDeviceNameChangedNotification {
+    public:
+        void onDeviceNameChanged(const std::string&) override
+        {
+        }
+    };
+
+    // The interfaces stay valid while the accessor lives, look them up once per thread
+    struct Context {
+        Context()
+            : account(Firebolt::IFireboltAccessor::Instance().AccountInterface())
+            , advertising(Firebolt::IFireboltAccessor::Instance().AdvertisingInterface())
+            , device(Firebolt::IFireboltAccessor::Instance().DeviceInterface())
+            , localization(Firebolt::IFireboltAccessor::Instance().LocalizationInterface())
+            , profile(Firebolt::IFireboltAccessor::Instance().ProfileInterface())
+            , lifecycle(Firebolt::IFireboltAccessor::Instance().LifecycleInterface())
+            , discovery(Firebolt::IFireboltAccessor::Instance().DiscoveryInterface())
+        {
+        }
+
+        Firebolt::Account::IAccount& account;
+        Firebolt::Advertising::IAdvertising& advertising;
+        Firebolt::Device::IDevice& device;
+        Firebolt::Localization::ILocalization& localization;
+        Firebolt::Profile::IProfile& profile;
+        Firebolt::Lifecycle::ILifecycle& lifecycle;
+        Firebolt::Discovery::IDiscovery& discovery;
+        NameChangedListener listener;
+    };
+
+    struct Operation {
+        const char* name;
+        std::function<Firebolt::Error(Context&)> call;
+    };
+
+    const Operation Operations[] = {
+        { "account.id", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.account.id(&error); return error; } },
+        { "advertising.policy", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.advertising.policy(&error); return error; } },
+        { "device.name", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.device.name(&error); return error; } },
+        { "device.model", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.device.model(&error); return error; } },
+        { "device.audio", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.device.audio(&error); return error; } },
+        { "localization.latlon", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.localization.latlon(&error); return error; } },
+        { "profile.flags", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.profile.flags(&error); return error; } },
+        // Answered from the state the SDK tracks, no round-trip
+        { "lifecycle.state", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.lifecycle.state(&error); return error; } },
+        { "discovery.policy", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.discovery.policy(&error); return error; } },
+        { "discovery.clearContentAccess", [](Context& context) { Firebolt::Error error = Firebolt::Error::None; context.discovery.clearContentAccess(&error); return error; } },
+        // Exercises the subscription bookkeeping of FireboltSDK::Event
+        { "device.onNameChanged", [](Context& context) {
+              Firebolt::Error error = Firebolt::Error::None;
+              context.device.subscribe(context.listener, &error);
+              if (error == Firebolt::Error::None) {
+                  context.device.unsubscribe(context.listener, &error);
+              }
+              return error;
+          } },
+    };
+    constexpr size_t OperationCount = sizeof(Operations) / sizeof(Operations[0]);
+
+    // RPCs only, local calls would inflate calls/s and dilute the percentiles
+    const char* DefaultMix = "device.name:4,account.id:2,localization.latlon:2,discovery.policy:2,device.onNameChanged:1";
+
+    struct Result {
+        FireboltSDK::LatencyHistogram latency;
+        std::atomic<uint64_t> errors { 0 };
+    };
+
+    bool ParseMix(const string& mix, vector<double>& weights)
+    {
+        weights.assign(OperationCount, 0);
+        stringstream stream(mix);
+        string entry;
+        while (getline(stream, entry, ',')) {
+            const size_t colon = entry.find(':');
+            const string name = entry.substr(0, colon);
+            const double weight = (colon == string::npos) ? 1 : atof(entry.c_str() + colon + 1);
+            size_t index = 0;
+            while ((index < OperationCount) && (name != Operations[index].name)) {
+                ++index;
+            }
+            if ((index == OperationCount) || (weight < 0)) {
+                cout << "Unknown call in mix: " << entry << endl;
+                return false;
+            }
+            weights[index] = weight;
+        }
+        for (const double weight : weights) {
+            if (weight > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t StatusKiB(const char* field)
+    {
+        ifstream status("/proc/self/status");
+        string line;
+        while (getline(status, line)) {
+            if (line.compare(0, strlen(field), field) == 0) {
+                return strtoull(line.c_str() + strlen(field) + 1, nullptr, 10);
+            }
+        }
+        return 0;
+    }
+
+    double CpuSeconds()
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+    void Worker(const vector<double>& weights, const uint32_t seed, const chrono::steady_clock::time_point end, Result* results)
+    {
+        Context context;
+        mt19937 random(seed);
+        discrete_distribution<size_t> pick(weights.begin(), weights.end());
+        while (chrono::steady_clock::now() < end) {
+            const size_t index = pick(random);
+            const uint64_t start = FireboltSDK::Trace::Now();
+            const Firebolt::Error error = Operations[index].call(context);
+            results[index].latency.Record((FireboltSDK::Trace::Now() - start) / 1000);
+            if (error != Firebolt::Error::None) {
+                results[index].errors.fetch_add(1, memory_order_relaxed);
+            }
+        }
+    }
+
+    void Usage(const char* name)
+    {
+        cout << name << " [-u ws://ip:port] [-n threads] [-d seconds] [-m call:weight,...] [-a]" << endl;
+        cout << "  -a writes the SDK log from a background thread (FireboltSDK::AsyncLogger)" << endl;
+        cout << "  default mix " << DefaultMix << endl;
+        cout << "  calls:";
+        for (const Operation& operation : Operations) {
+            cout << " " << operation.name;
+        }
+        cout << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    string url = "ws://127.0.0.1:9998";
+    uint32_t threads = 4;
+    uint32_t duration = 10;
+    string mix = DefaultMix;
+    bool asyncLog = false;
+
+    int c;
+    while ((c = getopt(argc, argv, "u:n:d:m:ah")) != -1) {
+        switch (c) {
+        case 'u':
+            url = optarg;
+            break;
+        case 'n':
+            threads = max(1, atoi(optarg));
+            break;
+        case 'd':
+            duration = max(1, atoi(optarg));
+            break;
+        case 'm':
+            mix = optarg;
+            break;
+        case 'a':
+            asyncLog = true;
+            break;
+        default:
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+    vector<double> weights;
+    if (ParseMix(mix, weights) == false) {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    CoreSDKTest::CreateFireboltInstance(url);
+    if (asyncLog == true) {
+        FireboltSDK::AsyncLogger::Instance().Start(FireboltSDK::Logger::LogLevel::Info);
+    }
+    if (CoreSDKTest::WaitOnConnectionReady() == false) {
+        cout << "Load generator not able to connect with server..." << endl;
+        return 1;
+    }
+
+    unique_ptr<Result[]> results(new Result[OperationCount]);
+    const uint64_t rssBefore = StatusKiB("VmRSS:");
+    const double cpuBefore = CpuSeconds();
+    const auto start = chrono::steady_clock::now();
+    const auto end = start + chrono::seconds(duration);
+
+    vector<thread> workers;
+    for (uint32_t index = 0; index < threads; ++index) {
+        workers.emplace_back(Worker, cref(weights), index + 1, end, results.get());
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    const double cpu = CpuSeconds() - cpuBefore;
+    const uint64_t rssAfter = StatusKiB("VmRSS:");
+    const uint64_t rssPeak = StatusKiB("VmHWM:");
+
+    CoreSDKTest::DestroyFireboltInstance();
+    if (asyncLog == true) {
+        FireboltSDK::AsyncLogger::Instance().Stop();
+    }
+
+    uint64_t total = 0;
+    uint64_t errors = 0;
+    cout << left << setw(30) << "call" << right << setw(10) << "ops" << setw(10) << "ops/s" << setw(8) << "errors"
+         << setw(10) << "p50 us" << setw(10) << "p90 us" << setw(10) << "p99 us" << setw(10) << "max us" << endl;
+    for (size_t index = 0; index < OperationCount; ++index) {
+        const FireboltSDK::LatencyHistogram::Summary summary = results[index].latency.Summarize();
+        if (summary.count == 0) {
+            continue;
+        }
+        const uint64_t failed = results[index].errors.load(memory_order_relaxed);
+        total += summary.count;
+        errors += failed;
+        cout << left << setw(30) << Operations[index].name << right << setw(10) << summary.count
+             << setw(10) << fixed << setprecision(0) << (summary.count / elapsed) << setw(8) << failed
+             << setw(10) << summary.p50 << setw(10) << summary.p90 << setw(10) << summary.p99 << setw(10) << summary.max << endl;
+    }
+    cout << endl
+         << threads << " threads, " << setprecision(1) << elapsed << " s: " << total << " calls, "
+         << setprecision(0) << (total / elapsed) << " calls/s, " << errors << " errors" << endl
+         << "CPU " << setprecision(1) << (100 * cpu / elapsed) << "% of one core (" << setprecision(2) << (cpu * 1e6 / max<uint64_t>(total, 1)) << " us/call)" << endl
+         << "RSS " << rssAfter << " KiB (" << static_cast<int64_t>(rssAfter - rssBefore) << " KiB during the run, peak " << rssPeak << " KiB)" << endl;
+    if (asyncLog == true) {
+        cout << "Log records dropped " << FireboltSDK::AsyncLogger::Instance().Dropped() << endl;
+    }
+
+    return (errors == 0) ? 0 : 2;
+}
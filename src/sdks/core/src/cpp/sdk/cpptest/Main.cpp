@@ -17,27 +17,113 @@
  */
 
 #include <getopt.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <stdexcept>
 #include "CoreSDKTest.h"
+#include "Instrumentation/Trace.h"
 
 using namespace std;
 
-const char* options = ":hu:";
+const char* options = ":hu:t:b:o:";
+static string traceFile;
+static uint32_t iterations = 1;
+static string resultFile;
+
+struct TestResult {
+    string name;
+    uint32_t iterations;
+    double mean; // us
+    double p99;
+    uint32_t errors;
+};
+
+// JSON, or CSV if the file name ends in .csv; stdout if there is no file
+static void WriteResults(const vector<TestResult>& results) {
+    const bool csv = (resultFile.size() >= 4) && (resultFile.compare(resultFile.size() - 4, 4, ".csv") == 0);
+    FILE* file = resultFile.empty() ? stdout : fopen(resultFile.c_str(), "w");
+    if (file == nullptr) {
+        cout << "Unable to write results to " << resultFile << endl;
+        return;
+    }
+    fprintf(file, csv ? "name,iterations,mean_us,p99_us,errors\n" : "[\n");
+    for (const TestResult& result : results) {
+        const char* separator = (&result != &results.back()) ? "," : "";
+        if (csv) {
+            fprintf(file, "%s,%u,%.1f,%.1f,%u\n", result.name.c_str(), result.iterations, result.mean, result.p99, result.errors);
+        } else {
+            fprintf(file, "  {\"name\":\"%s\",\"iterations\":%u,\"mean_us\":%.1f,\"p99_us\":%.1f,\"errors\":%u}%s\n",
+                result.name.c_str(), result.iterations, result.mean, result.p99, result.errors, separator);
+        }
+    }
+    if (csv == false) {
+        fprintf(file, "]\n");
+    }
+    if (file != stdout) {
+        fclose(file);
+        cout << "Results written to " << resultFile << endl;
+    }
+}
+
+static void ExportTrace() {
+    if (FireboltSDK::Trace::Instance().Export(traceFile) == true) {
+        cout << "Trace written to " << traceFile << endl;
+    } else {
+        cout << "Unable to write trace to " << traceFile << endl;
+    }
+}
 
 void RunAllTests() {
     bool allTestsPassed = true;
     vector<string> errorMessages;
+    vector<TestResult> results;
+
+    // In benchmark mode (-b N) the first run is a warm-up with output, the N timed runs are silent.
+    // Tests that change state (subscriptions, setters, lifecycle transitions) are not repeatable,
+    // they run once through runOnce and are left out of the benchmark results.
+    auto runTest = [&allTestsPassed, &errorMessages, &results](auto testFunction, const string& testName, const bool repeatable = true) {
+        const uint32_t runs = ((repeatable == true) && (iterations > 1)) ? (iterations + 1) : 1;
+        vector<double> samples;
+        samples.reserve(runs);
+        uint32_t errors = 0;
+        streambuf* output = cout.rdbuf();
+        for (uint32_t run = 0; run < runs; ++run) {
+            if ((run == 1) && (runs > 1)) {
+                cout.rdbuf(nullptr);
+            }
+            const auto start = chrono::steady_clock::now();
+            try {
+                testFunction();
+            } catch (const exception& e) {
+                if (errors++ == 0) {
+                    errorMessages.push_back("Test " + testName + " failed: " + e.what());
+                }
+                allTestsPassed = false;
+            }
+            if ((run > 0) || (runs == 1)) {
+                samples.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+            }
+        }
+        cout.rdbuf(output);
+        cout.clear();
 
-    auto runTest = [&allTestsPassed, &errorMessages](auto testFunction, const string& testName) {
-        try {
-            testFunction();
-        } catch (const exception& e) {
-            errorMessages.push_back("Test " + testName + " failed: " + e.what());
-            allTestsPassed = false;
+        double total = 0;
+        for (const double sample : samples) {
+            total += sample;
         }
+        if ((repeatable == false) && (iterations > 1)) {
+            return;
+        }
+        sort(samples.begin(), samples.end());
+        const size_t rank = (samples.size() * 99 + 99) / 100;
+        results.push_back({ testName, static_cast<uint32_t>(samples.size()), total / samples.size(), samples[rank - 1], errors });
+    };
+    auto runOnce = [&runTest](auto testFunction, const string& testName) {
+        runTest(testFunction, testName, false);
     };
 
     // Ensure the connection is ready before running tests
@@ -51,34 +137,34 @@ void RunAllTests() {
         // Advertising methods
         runTest(CoreSDKTest::BuildAdvertisingConfiguration, "BuildAdvertisingConfiguration");
         runTest(CoreSDKTest::GetAdvertisingDeviceAttributes, "GetAdvertisingDeviceAttributes");
-        runTest(CoreSDKTest::SubscribeAdvertisingPolicyChanged, "SubscribeAdvertisingPolicyChanged");
-        runTest(CoreSDKTest::UnsubscribeAdvertisingPolicyChanged, "UnsubscribeAdvertisingPolicyChanged");
+        runOnce(CoreSDKTest::SubscribeAdvertisingPolicyChanged, "SubscribeAdvertisingPolicyChanged");
+        runOnce(CoreSDKTest::UnsubscribeAdvertisingPolicyChanged, "UnsubscribeAdvertisingPolicyChanged");
 
         // Device properties
         runTest(CoreSDKTest::GetDeviceModel, "GetDeviceModel");
         runTest(CoreSDKTest::GetDeviceSku, "GetDeviceSku");
         runTest(CoreSDKTest::GetDeviceName, "GetDeviceName");
         runTest(CoreSDKTest::GetDeviceName, "GetDeviceVersion");
-        runTest(CoreSDKTest::SubscribeDeviceNameChanged, "SubscribeDeviceNameChanged");
-        runTest(CoreSDKTest::UnsubscribeDeviceNameChanged, "UnsubscribeDeviceNameChanged");
+        runOnce(CoreSDKTest::SubscribeDeviceNameChanged, "SubscribeDeviceNameChanged");
+        runOnce(CoreSDKTest::UnsubscribeDeviceNameChanged, "UnsubscribeDeviceNameChanged");
         runTest(CoreSDKTest::GetDeviceAudio, "GetDeviceAudio");
-        runTest(CoreSDKTest::SubscribeDeviceAudioChanged, "SubscribeDeviceAudioChanged");
-        runTest(CoreSDKTest::UnsubscribeDeviceAudioChanged, "UnsubscribeDeviceAudioChanged");
+        runOnce(CoreSDKTest::SubscribeDeviceAudioChanged, "SubscribeDeviceAudioChanged");
+        runOnce(CoreSDKTest::UnsubscribeDeviceAudioChanged, "UnsubscribeDeviceAudioChanged");
         runTest(CoreSDKTest::GetDeviceScreenResolution, "GetDeviceScreenResolution");
-        runTest(CoreSDKTest::SubscribeDeviceScreenResolutionChanged, "SubscribeDeviceScreenResolutionChanged");
-        runTest(CoreSDKTest::UnsubscribeDeviceScreenResolutionChanged, "UnsubscribeDeviceScreenResolutionChanged");
+        runOnce(CoreSDKTest::SubscribeDeviceScreenResolutionChanged, "SubscribeDeviceScreenResolutionChanged");
+        runOnce(CoreSDKTest::UnsubscribeDeviceScreenResolutionChanged, "UnsubscribeDeviceScreenResolutionChanged");
 
         // Localization methods
         runTest(CoreSDKTest::GetLocalizationAdditionalInfo, "GetLocalizationAdditionalInfo");
         runTest(CoreSDKTest::GetLocalizationLatlon, "GetLocalizationLatlon");
         runTest(CoreSDKTest::GetLocalizationPreferredAudioLanguages, "GetLocalizationPreferredAudioLanguages");
-        runTest(CoreSDKTest::SubscribeLocalizationPreferredAudioLanguagesChanged, "SubscribeLocalizationPreferredAudioLanguagesChanged");
-        runTest(CoreSDKTest::UnsubscribeLocalizationPreferredAudioLanguagesChanged, "UnsubscribeLocalizationPreferredAudioLanguagesChanged");
+        runOnce(CoreSDKTest::SubscribeLocalizationPreferredAudioLanguagesChanged, "SubscribeLocalizationPreferredAudioLanguagesChanged");
+        runOnce(CoreSDKTest::UnsubscribeLocalizationPreferredAudioLanguagesChanged, "UnsubscribeLocalizationPreferredAudioLanguagesChanged");
 
         // Accessibility - Closed Captions Settings
         runTest(CoreSDKTest::GetAccessibilityClosedCaptionsSettings, "GetAccessibilityClosedCaptionsSettings");
-        runTest(CoreSDKTest::SubscribeAccessibilityClosedCaptionsSettingsChanged, "SubscribeAccessibilityClosedCaptionsSettingsChanged");
-        runTest(CoreSDKTest::UnsubscribeAccessibilityClosedCaptionsSettingsChanged, "UnsubscribeAccessibilityClosedCaptionsSettingsChanged");
+        runOnce(CoreSDKTest::SubscribeAccessibilityClosedCaptionsSettingsChanged, "SubscribeAccessibilityClosedCaptionsSettingsChanged");
+        runOnce(CoreSDKTest::UnsubscribeAccessibilityClosedCaptionsSettingsChanged, "UnsubscribeAccessibilityClosedCaptionsSettingsChanged");
 
         // Keyboard methods
         // runTest(CoreSDKTest::InvokeKeyboardEmail, "InvokeKeyboardEmail");
@@ -107,14 +193,15 @@ void RunAllTests() {
         runTest(CoreSDKTest::GetCapabilitiesInfo, "GetCapabilitiesInfo");
 
         // Lifecycle methods
-        // runTest(CoreSDKTest::LifecycleClose, "LifecycleClose");
-        runTest(CoreSDKTest::LifecycleReady, "LifecycleReady");
-        runTest(CoreSDKTest::LifecycleFinished, "LifecycleFinished");
+        // runOnce(CoreSDKTest::LifecycleClose, "LifecycleClose");
+        runOnce(CoreSDKTest::LifecycleReady, "LifecycleReady");
+        runOnce(CoreSDKTest::LifecycleFinished, "LifecycleFinished");
         runTest(CoreSDKTest::LifecycleState, "LifecycleState");
-        runTest(CoreSDKTest::SubscribeLifecycleBackgroundNotification, "SubscribeLifecycleBackgroundNotification");
-        runTest(CoreSDKTest::UnsubscribeLifecycleBackgroundNotification, "UnsubscribeLifecycleBackgroundNotification");
-        runTest(CoreSDKTest::SubscribeLifecycleForegroundNotification, "SubscribeLifecycleForegroundNotification");
-        runTest(CoreSDKTest::UnsubscribeLifecycleForegroundNotification, "UnsubscribeLifecycleForegroundNotification");
+        runTest(CoreSDKTest::LifecycleWaitForState, "LifecycleWaitForState");
+        runOnce(CoreSDKTest::SubscribeLifecycleBackgroundNotification, "SubscribeLifecycleBackgroundNotification");
+        runOnce(CoreSDKTest::UnsubscribeLifecycleBackgroundNotification, "UnsubscribeLifecycleBackgroundNotification");
+        runOnce(CoreSDKTest::SubscribeLifecycleForegroundNotification, "SubscribeLifecycleForegroundNotification");
+        runOnce(CoreSDKTest::UnsubscribeLifecycleForegroundNotification, "UnsubscribeLifecycleForegroundNotification");
 
         // Metrics methods
         runTest(CoreSDKTest::MetricsReady, "MetricsReady");
@@ -128,31 +215,38 @@ void RunAllTests() {
         // SecondScreen methods
         runTest(CoreSDKTest::GetSecondScreenDevice, "GetSecondScreenDevice");
         runTest(CoreSDKTest::GetSecondScreenFriendlyName, "GetSecondScreenFriendlyName");
-        runTest(CoreSDKTest::SubscribeSecondScreenFriendlyNameChanged, "SubscribeSecondScreenFriendlyNameChanged");
-        runTest(CoreSDKTest::UnsubscribeSecondScreenFriendlyNameChanged, "UnsubscribeSecondScreenFriendlyNameChanged");
+        runOnce(CoreSDKTest::SubscribeSecondScreenFriendlyNameChanged, "SubscribeSecondScreenFriendlyNameChanged");
+        runOnce(CoreSDKTest::UnsubscribeSecondScreenFriendlyNameChanged, "UnsubscribeSecondScreenFriendlyNameChanged");
         runTest(CoreSDKTest::GetSecondScreenProtocols, "GetSecondScreenProtocols");
 
         // Discovery methods
-        runTest(CoreSDKTest::DiscoverySignIn, "DiscoverySignIn");
-        runTest(CoreSDKTest::DiscoverySignOut, "DiscoverySignOut");
-        runTest(CoreSDKTest::DiscoveryContentAccess, "DiscoveryContentAccess");
-        runTest(CoreSDKTest::DiscoveryClearContentAccess, "DiscoveryClearContentAccess");
-        runTest(CoreSDKTest::DiscoveryEntitlements, "DiscoveryEntitlements");
-        runTest(CoreSDKTest::DiscoveryEntityInfo, "DiscoveryEntityInfo");
+        runOnce(CoreSDKTest::DiscoverySignIn, "DiscoverySignIn");
+        runOnce(CoreSDKTest::DiscoverySignOut, "DiscoverySignOut");
+        runOnce(CoreSDKTest::DiscoveryContentAccess, "DiscoveryContentAccess");
+        runOnce(CoreSDKTest::DiscoveryClearContentAccess, "DiscoveryClearContentAccess");
+        runOnce(CoreSDKTest::DiscoveryEntitlements, "DiscoveryEntitlements");
+        runOnce(CoreSDKTest::DiscoveryEntityInfo, "DiscoveryEntityInfo");
         runTest(CoreSDKTest::DiscoveryPolicy, "DiscoveryPolicy");
-        runTest(CoreSDKTest::DiscoveryPurchasedContent, "DiscoveryPurchasedContent");
-        runTest(CoreSDKTest::DiscoveryWatchNext, "DiscoveryWatchNext");
-        runTest(CoreSDKTest::DiscoveryLaunch, "DiscoveryLaunch");
+        runOnce(CoreSDKTest::DiscoveryPurchasedContent, "DiscoveryPurchasedContent");
+        runOnce(CoreSDKTest::DiscoveryWatchNext, "DiscoveryWatchNext");
+        runOnce(CoreSDKTest::DiscoveryLaunch, "DiscoveryLaunch");
 #ifdef POLYMORPHICS_REDUCER_METHODS
-        runTest(CoreSDKTest::DiscoveryWatched, "DiscoveryWatched");
-        runTest(CoreSDKTest::DiscoveryWatchedReduced, "DiscoveryWatchedReduced");
+        runOnce(CoreSDKTest::DiscoveryWatched, "DiscoveryWatched");
+        runOnce(CoreSDKTest::DiscoveryWatchedReduced, "DiscoveryWatchedReduced");
 #endif
-        runTest(CoreSDKTest::SubscribeDiscoveryOnNavigateToLaunchNotification, "SubscribeDiscoveryOnNavigateToLaunchNotification");
-        runTest(CoreSDKTest::UnsubscribeDiscoveryOnNavigateToLaunchNotification, "UnsubscribeDiscoveryOnNavigateToLaunchNotification");
+        runOnce(CoreSDKTest::SubscribeDiscoveryOnNavigateToLaunchNotification, "SubscribeDiscoveryOnNavigateToLaunchNotification");
+        runOnce(CoreSDKTest::UnsubscribeDiscoveryOnNavigateToLaunchNotification, "UnsubscribeDiscoveryOnNavigateToLaunchNotification");
 
         // Parameters Initialization
         runTest(CoreSDKTest::ParametersInitialization, "ParametersInitialization");
 
+        // Latency of the calls made above
+        runTest(CoreSDKTest::LatencySnapshot, "LatencySnapshot");
+
+        if ((resultFile.empty() == false) || (iterations > 1)) {
+            WriteResults(results);
+        }
+
         if (allTestsPassed) {
             cout << "============================" << endl;
             cout << "ALL CORE SDK TESTS SUCCEEDED!" << endl;
@@ -180,14 +274,30 @@ int main(int argc, char* argv[]) {
             case 'u':
                 url = optarg;
                 break;
+            case 't':
+                traceFile = optarg;
+                break;
+            case 'b':
+                iterations = max(1, atoi(optarg));
+                break;
+            case 'o':
+                resultFile = optarg;
+                break;
             case 'h':
-                printf("./TestFireboltManage -u ws://ip:port\n");
+                printf("./TestFireboltCore -u ws://ip:port [-t trace.json] [-b iterations] [-o results.json|results.csv]\n");
+                printf("  -b repeats the tests that do not change state, the others run once\n");
                 exit(1);
         }
     }
 
     printf("Firebolt Core SDK Test\n");
 
+    // Record from before the connection is made, so the startup calls are in the trace too
+    if (traceFile.empty() == false) {
+        FireboltSDK::Trace::Instance().Start(65536);
+        atexit(ExportTrace);
+    }
+
     CoreSDKTest::CreateFireboltInstance(url);
     RunAllTests();
     CoreSDKTest::DestroyFireboltInstance();
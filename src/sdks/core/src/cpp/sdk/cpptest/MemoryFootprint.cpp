@@ -0,0 +1,170 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// firebolt-memory: heap usage per SDK area over a representative session. Build the SDK
+// with -DFIREBOLT_MEMORY_ACCOUNTING as well, otherwise everything is "unattributed".
+//
+// Usage of every area is shown once connected, after the session calls, once idle with the
+// subscriptions in place (steady state) and after the SDK is disposed (leaks), followed by
+// the peak of the whole run.
+//
+// Static data of the SDK is constant initialized, so nothing may have been allocated before
+// Initialize; the tool fails if the libraries loaded with it allocated during startup.
+
+#include <getopt.h>
+#include <unistd.h>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "CoreSDKTest.h"
+#include "Instrumentation/Memory.h"
+
+FIREBOLT_MEMORY_ACCOUNTING_HOOKS
+
+using namespace std;
+
+namespace {
+
+    struct Session {
+        const char* name;
+        std::function<void()> call;
+    };
+
+    const Session Calls[] = {
+        { "LifecycleReady", CoreSDKTest::LifecycleReady },
+        { "GetDeviceName", CoreSDKTest::GetDeviceName },
+        { "GetDeviceVersion", CoreSDKTest::GetDeviceVersion },
+        { "GetDeviceAudio", CoreSDKTest::GetDeviceAudio },
+        { "GetAccountId", CoreSDKTest::GetAccountId },
+        { "GetLocalizationLatlon", CoreSDKTest::GetLocalizationLatlon },
+        { "GetAccessibilityClosedCaptionsSettings", CoreSDKTest::GetAccessibilityClosedCaptionsSettings },
+        { "GetProfileFlags", CoreSDKTest::GetProfileFlags },
+        { "DiscoveryPolicy", CoreSDKTest::DiscoveryPolicy },
+        { "SubscribeDeviceNameChanged", CoreSDKTest::SubscribeDeviceNameChanged },
+        { "SubscribeAccessibilityClosedCaptionsSettingsChanged", CoreSDKTest::SubscribeAccessibilityClosedCaptionsSettingsChanged },
+        { "SubscribeLifecycleBackgroundNotification", CoreSDKTest::SubscribeLifecycleBackgroundNotification },
+        { "MetricsStartContent", CoreSDKTest::MetricsStartContent },
+        { "MetricsStopContent", CoreSDKTest::MetricsStopContent },
+    };
+
+    // Subscriptions are kept until the steady state is measured
+    const Session Teardown[] = {
+        { "UnsubscribeDeviceNameChanged", CoreSDKTest::UnsubscribeDeviceNameChanged },
+        { "UnsubscribeAccessibilityClosedCaptionsSettingsChanged", CoreSDKTest::UnsubscribeAccessibilityClosedCaptionsSettingsChanged },
+        { "UnsubscribeLifecycleBackgroundNotification", CoreSDKTest::UnsubscribeLifecycleBackgroundNotification },
+    };
+
+    const char* Stages[] = { "connected", "session", "steady", "disposed" };
+    constexpr uint32_t StageCount = sizeof(Stages) / sizeof(Stages[0]);
+
+    map<string, vector<int64_t>> usage;
+
+    void Measure(const uint32_t stage)
+    {
+        for (const FireboltSDK::Memory::Usage& area : FireboltSDK::Memory::Instance().Snapshot()) {
+            vector<int64_t>& bytes = usage[area.tag];
+            bytes.resize(StageCount + 1, 0);
+            bytes[stage] = area.current;
+            bytes[StageCount] = area.peak;
+        }
+    }
+
+    uint32_t Run(const Session* calls, const size_t count)
+    {
+        uint32_t failed = 0;
+        for (size_t index = 0; index < count; ++index) {
+            try {
+                calls[index].call();
+            } catch (const exception& e) {
+                printf("%s failed: %s\n", calls[index].name, e.what());
+                ++failed;
+            }
+        }
+        return failed;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const uint64_t staticAllocations = FireboltSDK::Memory::Instance().Allocations();
+    string url = "ws://127.0.0.1:9998";
+    uint32_t idleSeconds = 5;
+
+    int c;
+    while ((c = getopt(argc, argv, "u:i:h")) != -1) {
+        switch (c) {
+        case 'u':
+            url = optarg;
+            break;
+        case 'i':
+            idleSeconds = static_cast<uint32_t>(atoi(optarg));
+            break;
+        default:
+            printf("%s [-u ws://ip:port] [-i idle seconds before the steady state]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("Allocations before Initialize: %llu\n", static_cast<unsigned long long>(staticAllocations));
+    if (staticAllocations != 0) {
+        return 3;
+    }
+
+    CoreSDKTest::CreateFireboltInstance(url);
+    if (CoreSDKTest::WaitOnConnectionReady() == false) {
+        printf("Memory footprint not able to connect with server...\n");
+        return 1;
+    }
+    Measure(0);
+
+    uint32_t failed = Run(Calls, sizeof(Calls) / sizeof(Calls[0]));
+    Measure(1);
+
+    sleep(idleSeconds);
+    Measure(2);
+
+    failed += Run(Teardown, sizeof(Teardown) / sizeof(Teardown[0]));
+    CoreSDKTest::DestroyFireboltInstance();
+    Measure(3);
+
+    printf("\nHeap bytes per area\n%-16s", "area");
+    for (const char* stage : Stages) {
+        printf("%12s", stage);
+    }
+    printf("%12s\n", "peak");
+    vector<int64_t> totals(StageCount + 1, 0);
+    for (const auto& area : usage) {
+        printf("%-16s", area.first.c_str());
+        for (uint32_t stage = 0; stage <= StageCount; ++stage) {
+            printf("%12lld", static_cast<long long>(area.second[stage]));
+            totals[stage] += area.second[stage];
+        }
+        printf("\n");
+    }
+    printf("%-16s", "total");
+    for (uint32_t stage = 0; stage < StageCount; ++stage) {
+        printf("%12lld", static_cast<long long>(totals[stage]));
+    }
+    // Peaks of the areas are not simultaneous, their sum is an upper bound
+    printf("%11lld+\n", static_cast<long long>(totals[StageCount]));
+
+    return (failed == 0) ? 0 : 2;
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2023 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// firebolt-startup: times the SDK cold start phase by phase, from Initialize to the first
+// successful getters, and prints the phases as JSON (one process is one cold start).
+//
+//   for i in $(seq 20); do ./firebolt-startup -o startup-$i.json; done
+
+#include <getopt.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "firebolt.h"
+#include "Instrumentation/Latency.h"
+
+using namespace std;
+
+namespace {
+
+    struct Phase {
+        string name;
+        uint64_t start; // us since static initialization
+        uint64_t end;
+        int error;
+    };
+
+    const uint64_t Origin = FireboltSDK::Trace::Now();
+
+    uint64_t Elapsed()
+    {
+        return (FireboltSDK::Trace::Now() - Origin) / 1000;
+    }
+
+    std::atomic<uint64_t> connectedAt { 0 };
+
+    void ConnectionChanged(const bool connected, const Firebolt::Error)
+    {
+        if (connected == true) {
+            uint64_t expected = 0;
+            connectedAt.compare_exchange_strong(expected, Elapsed());
+        }
+    }
+
+    // Runs one phase and records it, returns false if it failed
+    template <typename CALL>
+    bool Measure(vector<Phase>& phases, const char* name, CALL call)
+    {
+        Phase phase { name, Elapsed(), 0, 0 };
+        Firebolt::Error error = Firebolt::Error::None;
+        call(&error);
+        phase.end = Elapsed();
+        phase.error = static_cast<int>(error);
+        phases.push_back(phase);
+        return error == Firebolt::Error::None;
+    }
+
+    uint64_t InvokeTime(const char* method)
+    {
+        for (const FireboltSDK::Latency::MethodLatency& entry : FireboltSDK::Latency::Instance().Snapshot()) {
+            if (entry.method == method) {
+                return entry.invoke.max;
+            }
+        }
+        return 0;
+    }
+
+    string ToJson(const vector<Phase>& phases, const uint64_t firstCall, const bool succeeded)
+    {
+        string json = "{\"origin\":" + to_string(Origin / 1000) + ",\"phases\":[";
+        for (const Phase& phase : phases) {
+            json += ((&phase != &phases.front()) ? ",{" : "{");
+            json += "\"name\":\"" + phase.name + "\",\"start\":" + to_string(phase.start) + ",\"end\":" + to_string(phase.end)
+                + ",\"duration\":" + to_string(phase.end - phase.start) + ",\"error\":" + to_string(phase.error) + "}";
+        }
+        json += "],\"firstCall\":" + to_string(firstCall) + ",\"succeeded\":" + (succeeded ? "true" : "false") + "}\n";
+        return json;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    string url = "ws://127.0.0.1:9998";
+    string output;
+    uint32_t timeoutMs = 10000;
+
+    int c;
+    while ((c = getopt(argc, argv, "u:o:w:h")) != -1) {
+        switch (c) {
+        case 'u':
+            url = optarg;
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'w':
+            timeoutMs = static_cast<uint32_t>(atoi(optarg));
+            break;
+        default:
+            printf("%s [-u ws://ip:port] [-o result.json] [-w connect timeout ms]\n", argv[0]);
+            printf("  times are in us since start-up, origin is the steady clock at start-up in us\n");
+            return 1;
+        }
+    }
+
+    const string config = "{\
+            \"waitTime\": 1000,\
+            \"logLevel\": \"Error\",\
+            \"workerPool\":{\
+            \"queueSize\": 8,\
+            \"threadCount\": 3\
+            },\
+            \"wsUrl\": " + url + "}";
+
+    vector<Phase> phases;
+    bool succeeded = Measure(phases, "initialize", [&config](Firebolt::Error* error) {
+        *error = Firebolt::IFireboltAccessor::Instance().Initialize(config);
+    });
+    succeeded = succeeded && Measure(phases, "connect", [](Firebolt::Error* error) {
+        *error = Firebolt::IFireboltAccessor::Instance().Connect(ConnectionChanged);
+    });
+    if (succeeded == true) {
+        // WebSocket handshake done, as reported through the connection callback
+        const uint64_t start = phases.back().end;
+        while ((connectedAt.load() == 0) && ((Elapsed() - start) < (timeoutMs * 1000ull))) {
+            usleep(100);
+        }
+        const uint64_t connected = connectedAt.load();
+        phases.push_back({ "handshake", start, (connected != 0) ? max(connected, start) : Elapsed(), (connected != 0) ? 0 : static_cast<int>(Firebolt::Error::Timedout) });
+        succeeded = (connected != 0);
+    }
+    if (succeeded == true) {
+        succeeded = Measure(phases, "lifecycle.ready", [](Firebolt::Error* error) {
+            Firebolt::IFireboltAccessor::Instance().LifecycleInterface().ready(error);
+        });
+        // Split ready into the event subscriptions and the lifecycle.ready call itself
+        const Phase ready = phases.back();
+        const uint64_t invoke = min(InvokeTime("lifecycle.ready"), ready.end - ready.start);
+        phases.pop_back();
+        phases.push_back({ "lifecycle.subscribe", ready.start, ready.end - invoke, ready.error });
+        phases.push_back({ "lifecycle.ready", ready.end - invoke, ready.end, ready.error });
+    }
+    succeeded = succeeded && Measure(phases, "device.version", [](Firebolt::Error* error) {
+        Firebolt::IFireboltAccessor::Instance().DeviceInterface().version(error);
+    });
+    // The startup KPI, end of the first successful getter
+    const uint64_t firstCall = (succeeded == true) ? phases.back().end : 0;
+    succeeded = succeeded && Measure(phases, "device.name", [](Firebolt::Error* error) {
+        Firebolt::IFireboltAccessor::Instance().DeviceInterface().name(error);
+    });
+    succeeded = succeeded && Measure(phases, "account.id", [](Firebolt::Error* error) {
+        Firebolt::IFireboltAccessor::Instance().AccountInterface().id(error);
+    });
+
+    const string json = ToJson(phases, firstCall, succeeded);
+    if (output.empty() == true) {
+        fputs(json.c_str(), stdout);
+    } else {
+        FILE* file = fopen(output.c_str(), "w");
+        if ((file == nullptr) || (fputs(json.c_str(), file) < 0) || (fclose(file) != 0)) {
+            fprintf(stderr, "Unable to write %s\n", output.c_str());
+            return 1;
+        }
+    }
+
+    Firebolt::IFireboltAccessor::Instance().Disconnect();
+    Firebolt::IFireboltAccessor::Instance().Deinitialize();
+    Firebolt::IFireboltAccessor::Instance().Dispose();
+
+    return (succeeded == true) ? 0 : 2;
+}
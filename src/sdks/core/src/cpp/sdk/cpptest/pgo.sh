@@ -0,0 +1,132 @@
+#!/bin/bash
+# Builds the Core SDK and the cpptest apps three times (Release) against firebolt-mock-server:
+#   baseline
+#   train      -flto -fprofile-generate, runs the workload to collect the profiles
+#   optimized  -flto -fprofile-use
+# The workload (startup, getter load, event storm, test cases) runs on baseline and
+# optimized as well. Their numbers end up side by side in <work>/results.
+usage()
+{
+   echo "options:"
+   echo "    -k generated SDK source path, e.g. src/sdks/core/build/cpp/src"
+   echo "    -t test path"
+   echo "    -w work path, default ./pgo"
+   echo "    -s sysroot path"
+   echo "    -d seconds per workload step, default 10"
+   echo "    -p mock server port, default 9998"
+   echo "    -h : help"
+   echo
+   echo "usage: "
+   echo "    ./pgo.sh -k sdkpath -t testpath -w workpath -s sysrootpath"
+}
+
+SdkPath=""
+TestPath="."
+WorkPath="./pgo"
+SysrootPath=${SYSROOT_PATH}
+Duration=10
+Port=9998
+while getopts k:t:w:s:d:p:h flag
+do
+    case "${flag}" in
+        k) SdkPath="${OPTARG}";;
+        t) TestPath="${OPTARG}";;
+        w) WorkPath="${OPTARG}";;
+        s) SysrootPath="${OPTARG}";;
+        d) Duration="${OPTARG}";;
+        p) Port="${OPTARG}";;
+        h) usage && exit 1;;
+    esac
+done
+
+if [ -z "${SdkPath}" ];
+then
+    usage && exit 1
+fi
+
+set -e
+TestPath=$(realpath ${TestPath})
+SdkPath=$(realpath ${SdkPath})
+mkdir -p ${WorkPath}
+WorkPath=$(realpath ${WorkPath})
+MockPath=$(realpath ${TestPath}/../../../../../../cpp/mock-server)
+Profiles=${WorkPath}/profiles
+Results=${WorkPath}/results
+Url="ws://127.0.0.1:${Port}"
+
+GenerateFlags="-fprofile-generate=${Profiles} -fprofile-update=atomic"
+if ${CXX:-c++} --version | grep -q clang;
+then
+    UseFlags="-fprofile-use=${Profiles}/default.profdata"
+else
+    UseFlags="-fprofile-use=${Profiles} -fprofile-correction -Wno-missing-profile"
+fi
+
+# build <name> <sdk build dir> <app build dir> <flags> <cmake options for the apps>
+# GCC matches profiles on object paths, so train and optimized share their build dirs
+build()
+{
+    local Stage=${WorkPath}/stage-$1
+    cmake -B$2 -S${SdkPath} -DCMAKE_BUILD_TYPE=Release -DSYSROOT_PATH=${SysrootPath} -DCMAKE_INSTALL_PREFIX=${Stage}/usr \
+        -DCMAKE_C_FLAGS="$4" -DCMAKE_CXX_FLAGS="$4" -DCMAKE_SHARED_LINKER_FLAGS="$4" -DCMAKE_EXE_LINKER_FLAGS="$4"
+    cmake --build $2 --target install
+    cmake -B$3 -S${TestPath} -DCMAKE_BUILD_TYPE=Release -DSYSROOT_PATH=${SysrootPath} -DFIREBOLT_PATH=${Stage} $5
+    cmake --build $3
+}
+
+# workload <name> <app build dir>
+workload()
+{
+    local Stage=${WorkPath}/stage-$1
+    export LD_LIBRARY_PATH=${Stage}/usr/lib:${LD_LIBRARY_PATH}
+    ${WorkPath}/mock/firebolt-mock-server -p ${Port} > ${Results}/$1-mock.txt &
+    local Mock=$!
+    trap "kill ${Mock} 2> /dev/null" EXIT
+    sleep 1
+
+    for Run in 1 2 3 4 5;
+    do
+        $2/firebolt-startup -u ${Url} -o ${Results}/$1-startup-${Run}.json > /dev/null
+    done
+    $2/firebolt-loadgen -u ${Url} -n 4 -d ${Duration} > ${Results}/$1-loadgen.txt
+    $2/firebolt-eventstorm -u ${Url} -r 500 -x 8000 -s $(( (Duration + 4) / 5 )) > ${Results}/$1-eventstorm.txt
+    $2/TestFireboltCore -u ${Url} -b 20 -o ${Results}/$1-tests.csv > /dev/null || true
+
+    kill ${Mock}
+    wait ${Mock} 2> /dev/null || true
+    trap - EXIT
+}
+
+summary()
+{
+    echo "== $1"
+    grep -h -o '"firstCall":[0-9]*' ${Results}/$1-startup-*.json | tr '\n' ' '
+    echo
+    grep -h "calls/s\|CPU\|RSS" ${Results}/$1-loadgen.txt
+    grep -h "Max sustained" ${Results}/$1-eventstorm.txt || true
+}
+
+rm -rf ${Profiles} ${Results}
+mkdir -p ${Profiles} ${Results}
+
+cmake -B${WorkPath}/mock -S${MockPath} -DCMAKE_BUILD_TYPE=Release
+cmake --build ${WorkPath}/mock --target firebolt-mock-server
+
+build baseline ${WorkPath}/sdk-baseline ${WorkPath}/apps-baseline "" ""
+workload baseline ${WorkPath}/apps-baseline
+
+build train ${WorkPath}/sdk ${WorkPath}/apps "-flto ${GenerateFlags}" \
+    "-DFIREBOLT_LTO=ON -DFIREBOLT_PGO=generate -DFIREBOLT_PGO_DIR=${Profiles}"
+workload train ${WorkPath}/apps
+if ${CXX:-c++} --version | grep -q clang;
+then
+    llvm-profdata merge -output=${Profiles}/default.profdata ${Profiles}/*.profraw
+fi
+
+build optimized ${WorkPath}/sdk ${WorkPath}/apps "-flto ${UseFlags}" \
+    "-DFIREBOLT_LTO=ON -DFIREBOLT_PGO=use -DFIREBOLT_PGO_DIR=${Profiles}"
+workload optimized ${WorkPath}/apps
+
+summary baseline
+summary optimized
+echo "Test case timings: ${Results}/baseline-tests.csv ${Results}/optimized-tests.csv"
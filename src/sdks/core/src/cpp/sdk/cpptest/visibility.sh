@@ -0,0 +1,119 @@
+#!/bin/bash
+# Builds the Core SDK twice (Release) and compares how it loads:
+#   default   everything exported, as built today
+#   reduced   -fvisibility-inlines-hidden and the explicit export set of src/exports.map in the SDK sources
+# Per build it reports the exported symbols and the dynamic relocations of the SDK library,
+# the dynamic loader statistics of firebolt-startup (LD_DEBUG=statistics: time spent in
+# ld.so and relocations processed) and the startup phases against firebolt-mock-server.
+usage()
+{
+   echo "options:"
+   echo "    -k generated SDK source path, e.g. src/sdks/core/build/cpp/src"
+   echo "    -t test path"
+   echo "    -w work path, default ./visibility"
+   echo "    -s sysroot path"
+   echo "    -r startup runs, default 10"
+   echo "    -p mock server port, default 9998"
+   echo "    -h : help"
+   echo
+   echo "usage: "
+   echo "    ./visibility.sh -k sdkpath -t testpath -w workpath -s sysrootpath"
+}
+
+SdkPath=""
+TestPath="."
+WorkPath="./visibility"
+SysrootPath=${SYSROOT_PATH}
+Runs=10
+Port=9998
+while getopts k:t:w:s:r:p:h flag
+do
+    case "${flag}" in
+        k) SdkPath="${OPTARG}";;
+        t) TestPath="${OPTARG}";;
+        w) WorkPath="${OPTARG}";;
+        s) SysrootPath="${OPTARG}";;
+        r) Runs="${OPTARG}";;
+        p) Port="${OPTARG}";;
+        h) usage && exit 1;;
+    esac
+done
+
+if [ -z "${SdkPath}" ];
+then
+    usage && exit 1
+fi
+
+set -e
+TestPath=$(realpath ${TestPath})
+SdkPath=$(realpath ${SdkPath})
+mkdir -p ${WorkPath}
+WorkPath=$(realpath ${WorkPath})
+MockPath=$(realpath ${TestPath}/../../../../../../cpp/mock-server)
+ExportMap=${SdkPath}/src/exports.map
+Results=${WorkPath}/results
+Url="ws://127.0.0.1:${Port}"
+
+# build <name> <compile flags> <link flags>
+build()
+{
+    local Stage=${WorkPath}/stage-$1
+    cmake -B${WorkPath}/sdk-$1 -S${SdkPath} -DCMAKE_BUILD_TYPE=Release -DSYSROOT_PATH=${SysrootPath} -DCMAKE_INSTALL_PREFIX=${Stage}/usr \
+        -DCMAKE_C_FLAGS="$2" -DCMAKE_CXX_FLAGS="$2" -DCMAKE_SHARED_LINKER_FLAGS="$3"
+    cmake --build ${WorkPath}/sdk-$1 --target install
+    cmake -B${WorkPath}/apps-$1 -S${TestPath} -DCMAKE_BUILD_TYPE=Release -DSYSROOT_PATH=${SysrootPath} -DFIREBOLT_PATH=${Stage}
+    cmake --build ${WorkPath}/apps-$1 --target firebolt-startup
+}
+
+# measure <name>
+measure()
+{
+    local Stage=${WorkPath}/stage-$1
+    local Library=$(ls ${Stage}/usr/lib/lib*SDK.so | head -n 1)
+    export LD_LIBRARY_PATH=${Stage}/usr/lib:${LD_LIBRARY_PATH}
+
+    {
+        echo "library:              $(basename ${Library}) $(stat -c %s ${Library}) bytes"
+        echo "exported symbols:     $(nm -D --defined-only ${Library} | wc -l)"
+        echo "dynamic relocations:  $(readelf -rW ${Library} | grep -c 'R_')"
+        echo "symbolic relocations: $(readelf -rW ${Library} | grep 'R_' | grep -vc '_RELATIVE')"
+    } > ${Results}/$1-library.txt
+
+    ${WorkPath}/mock/firebolt-mock-server -p ${Port} > ${Results}/$1-mock.txt &
+    local Mock=$!
+    trap "kill ${Mock} 2> /dev/null" EXIT
+    sleep 1
+
+    for Run in $(seq 1 ${Runs});
+    do
+        LD_DEBUG=statistics ${WorkPath}/apps-$1/firebolt-startup -u ${Url} -o ${Results}/$1-startup-${Run}.json \
+            2> ${Results}/$1-loader-${Run}.txt > /dev/null
+    done
+
+    kill ${Mock}
+    wait ${Mock} 2> /dev/null || true
+    trap - EXIT
+}
+
+summary()
+{
+    echo "== $1"
+    cat ${Results}/$1-library.txt
+    echo "loader time:          $(grep -h 'total startup time in dynamic loader' ${Results}/$1-loader-*.txt | grep -o '[0-9]* cycles' | tr '\n' ' ')"
+    echo "relocations:          $(grep -h 'number of relocations:' ${Results}/$1-loader-1.txt | grep -o '[0-9]*$')"
+    echo "first call (us):      $(grep -h -o '"firstCall":[0-9]*' ${Results}/$1-startup-*.json | cut -d: -f2 | tr '\n' ' ')"
+}
+
+rm -rf ${Results}
+mkdir -p ${Results}
+
+cmake -B${WorkPath}/mock -S${MockPath} -DCMAKE_BUILD_TYPE=Release
+cmake --build ${WorkPath}/mock --target firebolt-mock-server
+
+build default "" ""
+measure default
+build reduced "-fvisibility-inlines-hidden" "-Wl,--version-script=${ExportMap} -Wl,-O1 -Wl,--as-needed"
+measure reduced
+
+summary default
+summary reduced
@@ -17,6 +17,7 @@
  */
 
 #include "Module.h"
+#include "DateTime.h"
 #include "CoreSDKTestStaticCode.h"
 
 namespace FireboltSDK {
@@ -25,6 +26,12 @@ namespace FireboltSDK {
     {
         _functionMap.emplace(std::piecewise_construct, std::forward_as_tuple("Get Country Code"),
                              std::forward_as_tuple(&GetCountryCode));
+        _functionMap.emplace(std::piecewise_construct, std::forward_as_tuple("Parse Timestamp"),
+                             std::forward_as_tuple(&ParseTimestamp));
+        _functionMap.emplace(std::piecewise_construct, std::forward_as_tuple("Parse Number"),
+                             std::forward_as_tuple(&ParseNumber));
+        _functionMap.emplace(std::piecewise_construct, std::forward_as_tuple("Parse DateTime"),
+                             std::forward_as_tuple(&ParseDateTime));
     }
 
     /* static */ Firebolt::Error CoreTestStaticCode::GetCountryCode()
@@ -42,5 +49,97 @@ namespace FireboltSDK {
 
         return status;
     }
-}
 
+    /* static */ Firebolt::Error CoreTestStaticCode::ParseTimestamp()
+    {
+        struct Case {
+            const char* text;
+            bool valid;
+            int64_t milliseconds;
+        };
+        static const Case Cases[] = {
+            // Leap day
+            { "2024-02-29T12:00:00Z", true, 1709208000000 },
+            { "2000-02-29T00:00:00Z", true, 951782400000 },
+            { "2023-02-29T12:00:00Z", false, 0 },
+            { "1900-02-29T12:00:00Z", false, 0 },
+            // Date only, midnight UTC
+            { "2024-03-01", true, 1709251200000 },
+            { "2024-3-01", false, 0 },
+            { "2024-03-01T", false, 0 },
+            // Fraction, digits past milliseconds are dropped
+            { "2024-03-01T00:00:00.5Z", true, 1709251200500 },
+            { "2024-03-01T00:00:00.123456Z", true, 1709251200123 },
+            { "2024-03-01T00:00:00.Z", false, 0 },
+            { "2024-03-01T00:00:00.", false, 0 },
+            // Offsets
+            { "2024-03-01T01:30:00+01:30", true, 1709251200000 },
+            { "2024-02-29T22:30:00-01:30", true, 1709251200000 },
+            { "2024-03-01T00:00:00.250+00:00", true, 1709251200250 },
+            { "2024-03-01T00:00:00+24:00", false, 0 },
+            { "2024-03-01T00:00:00+0100", false, 0 },
+            { "2024-03-01T00:00:00", false, 0 },
+        };
+
+        Firebolt::Error status = Firebolt::Error::None;
+        for (const Case& entry : Cases) {
+            Timestamp timestamp;
+            const bool valid = Timestamp::Parse(string(entry.text), timestamp);
+            EXPECT_EQ(valid, entry.valid);
+            if ((valid != entry.valid) || ((valid == true) && (timestamp.Milliseconds() != entry.milliseconds))) {
+                FIREBOLT_LOG_ERROR(Logger::Category::Core, Logger::Module<Tests>(), "Timestamp %s parsed as %d, %lld", entry.text, valid, static_cast<long long>(timestamp.Milliseconds()));
+                status = Firebolt::Error::General;
+            }
+        }
+        return status;
+    }
+
+    /* static */ Firebolt::Error CoreTestStaticCode::ParseNumber()
+    {
+        Firebolt::Error status = Firebolt::Error::None;
+        double real = 0;
+        int32_t integer = 0;
+        uint8_t small = 0;
+
+        if ((FireboltSDK::ParseNumber(string("1.5"), real) == false) || (real != 1.5)
+            || (FireboltSDK::ParseNumber(string("-2e3"), real) == false) || (real != -2000)
+            || (FireboltSDK::ParseNumber(string("42"), integer) == false) || (integer != 42)
+            || (FireboltSDK::ParseNumber(string("255"), small) == false) || (small != 255)) {
+            status = Firebolt::Error::General;
+        }
+        // Out of range, trailing characters and empty text are rejected
+        if ((FireboltSDK::ParseNumber(string("1e400"), real) == true)
+            || (FireboltSDK::ParseNumber(string("1.5x"), real) == true)
+            || (FireboltSDK::ParseNumber(string(""), real) == true)
+            || (FireboltSDK::ParseNumber(string("256"), small) == true)
+            || (FireboltSDK::ParseNumber(string("42 "), integer) == true)) {
+            status = Firebolt::Error::General;
+        }
+        EXPECT_EQ(status, Firebolt::Error::None);
+        return status;
+    }
+
+    /* static */ Firebolt::Error CoreTestStaticCode::ParseDateTime()
+    {
+        Firebolt::Error status = Firebolt::Error::None;
+        DateTime dateTime;
+
+        if (dateTime.Time().IsValid() == true) {
+            status = Firebolt::Error::General;
+        }
+        dateTime.FromString(_T("\"2024-02-29T22:30:00-01:30\""));
+        if ((dateTime.Time().IsValid() == false) || (dateTime.Time().Milliseconds() != 1709251200000)) {
+            status = Firebolt::Error::General;
+        }
+        dateTime.FromString(_T("\"2024-02-30\""));
+        if ((dateTime.Value() != "2024-02-30") || (dateTime.Time().IsValid() == true)) {
+            status = Firebolt::Error::General;
+        }
+        dateTime.Clear();
+        if (dateTime.Time().IsValid() == true) {
+            status = Firebolt::Error::General;
+        }
+        EXPECT_EQ(status, Firebolt::Error::None);
+        return status;
+    }
+}
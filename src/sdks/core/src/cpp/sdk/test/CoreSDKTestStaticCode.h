@@ -57,5 +57,8 @@ namespace FireboltSDK {
         ~CoreTestStaticCode() override = default;
 
         static Firebolt::Error GetCountryCode();
+        static Firebolt::Error ParseTimestamp();
+        static Firebolt::Error ParseNumber();
+        static Firebolt::Error ParseDateTime();
     };
 }
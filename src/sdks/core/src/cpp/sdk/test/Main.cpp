@@ -31,6 +31,7 @@ int main()
 
     if (CoreSDKTestGeneratedCode::WaitOnConnectionReady() == true) {
         CoreSDKTestGeneratedCode::GetDeviceName();
+        CoreSDKTestGeneratedCode::TestCoreStaticSDK();
     }
     CoreSDKTestGeneratedCode::DestroyFireboltInstance();
     printf("TOTAL: %i tests; %i PASSED, %i FAILED\n", TotalTests, TotalTestsPassed, (TotalTests - TotalTestsPassed));
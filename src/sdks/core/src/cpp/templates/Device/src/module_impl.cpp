@@ -23,29 +23,24 @@ namespace Firebolt {
 namespace ${info.Title} {
 ${if.providers}
 /* ${PROVIDERS} */${end.if.providers}
+    static constexpr FireboltSDK::Method Version("${info.title.lowercase}.version");
+
     std::string ${info.Title}Impl::version(Firebolt::Error *err) const
     {
-        JsonObject jsonParameters;
-        JsonData_Versions jsonResult;
+        FIREBOLT_MEMORY_SCOPE("${info.title.lowercase}");
         std::string version;
 
-        Firebolt::Error status = Firebolt::Error::NotConnected;
-        FireboltSDK::Transport<WPEFramework::Core::JSON::IElement>* transport = FireboltSDK::Accessor::Instance().GetTransport();
-        if (transport != nullptr) {
-            
-            status = transport->Invoke("${info.title.lowercase}.version", jsonParameters, jsonResult);
-            if (status == Firebolt::Error::None) {
-                !jsonResult.IsSet() ? jsonResult.Clear() : (void)0;
-                !jsonResult.Sdk.IsSet() ? jsonResult.Sdk.Clear() : (void)0;
-                jsonResult.Sdk.Major = static_cast<int32_t>(${major});
-                jsonResult.Sdk.Minor = static_cast<int32_t>(${minor});
-                jsonResult.Sdk.Patch = static_cast<int32_t>(${patch});
-                jsonResult.Sdk.Readable = "${readable}";
-                jsonResult.ToString(version);
-            }
-
-        } else {
-            FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in getting Transport err = %d", status);
+        const Firebolt::Error status = FireboltSDK::InvokeMethod<JsonData_Versions>(Version, [&version](JsonData_Versions& jsonResult) {
+            !jsonResult.IsSet() ? jsonResult.Clear() : (void)0;
+            !jsonResult.Sdk.IsSet() ? jsonResult.Sdk.Clear() : (void)0;
+            jsonResult.Sdk.Major = static_cast<int32_t>(${major});
+            jsonResult.Sdk.Minor = static_cast<int32_t>(${minor});
+            jsonResult.Sdk.Patch = static_cast<int32_t>(${patch});
+            jsonResult.Sdk.Readable = "${readable}";
+            jsonResult.ToString(version);
+        });
+        if (err != nullptr) {
+            *err = status;
         }
         return version;
     }
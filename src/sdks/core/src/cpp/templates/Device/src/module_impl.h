@@ -19,7 +19,10 @@
 #pragma once
 
 #include "FireboltSDK.h"
+#include "Logger/AsyncLogger.h"
 #include "IModule.h"
+#include "Instrumentation/Latency.h"
+#include "Invoke.h"
 #include <string>
 
 
@@ -35,7 +38,7 @@ ${if.enums}
 ${if.types}
     // Types
 /* ${TYPES:json-types} */${end.if.types}
-    ${if.methods}class ${info.Title}Impl : public I${info.Title}, public IModule {
+    ${if.methods}class ${info.Title}Impl final : public I${info.Title}, public IModule {
 
     public:
         ${info.Title}Impl() = default;
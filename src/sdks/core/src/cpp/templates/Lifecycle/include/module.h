@@ -18,7 +18,9 @@
 #pragma once
 
 #include "error.h"
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 /* ${IMPORTS} */
 
 ${if.declarations}namespace Firebolt {
@@ -39,7 +41,9 @@ ${if.methods}struct I${info.Title} {
     virtual ~I${info.Title}() = default;
     virtual void ready(Firebolt::Error *err = nullptr) = 0;
     virtual void finished(Firebolt::Error *err = nullptr) = 0;
-    virtual std::string state(Firebolt::Error *err = nullptr) = 0;
+    virtual LifecycleState state(Firebolt::Error *err = nullptr) const = 0;
+    // Blocks until the app reaches the given state or timeoutMs elapses (Firebolt::Error::Timedout)
+    virtual bool waitForState(const LifecycleState state, const uint32_t timeoutMs, Firebolt::Error *err = nullptr) const = 0;
 
     // Methods & Events
     /* ${METHODS:declarations} */
@@ -49,11 +53,13 @@ ${if.methods}struct I${info.Title} {
 template<typename T>
 using EnumMap = std::unordered_map<T, std::string>;
 
-// Function to convert enum values to string representations
+// Function to convert enum values to string representations, "" if not in the map
 template <typename T>
-inline const std::string& ConvertEnum(EnumMap<T> enumMap, T type)
+inline const std::string& ConvertEnum(const EnumMap<T>& enumMap, T type)
 {
-    return enumMap[type];
+    static const std::string none;
+    const auto entry = enumMap.find(type);
+    return (entry != enumMap.end()) ? entry->second : none;
 }
 
 } //namespace ${info.Title}
@@ -17,6 +17,9 @@
 
 
 #include "${info.title.lowercase}_impl.h"
+#include <chrono>
+#include <future>
+#include <vector>
 
 ${if.implementations}
 namespace Firebolt {
@@ -24,24 +27,33 @@ namespace ${info.Title} {
 ${if.providers}
 /* ${PROVIDERS} */${end.if.providers}
 
-EnumMap<Firebolt::Lifecycle::LifecycleState> lifecycleStateMap = {
-    { Firebolt::Lifecycle::LifecycleState::INITIALIZING, "initializing" },
-    { Firebolt::Lifecycle::LifecycleState::INACTIVE, "inactive" },
-    { Firebolt::Lifecycle::LifecycleState::FOREGROUND, "foreground" },
-    { Firebolt::Lifecycle::LifecycleState::BACKGROUND, "background" },
-    { Firebolt::Lifecycle::LifecycleState::UNLOADING, "unloading" },
-    { Firebolt::Lifecycle::LifecycleState::SUSPENDED, "suspended" }
-};
+static constexpr FireboltSDK::Method Ready("lifecycle.ready");
+static constexpr FireboltSDK::Method Finished("lifecycle.finished");
+
+static const char* lifecycleStateName(const LifecycleState state)
+{
+    switch (state) {
+    case LifecycleState::INITIALIZING: return "initializing";
+    case LifecycleState::INACTIVE: return "inactive";
+    case LifecycleState::FOREGROUND: return "foreground";
+    case LifecycleState::BACKGROUND: return "background";
+    case LifecycleState::UNLOADING: return "unloading";
+    case LifecycleState::SUSPENDED: return "suspended";
+    }
+    return "unknown";
+}
 
 
 /* ready - Notify the platform that the app is ready */
 static void readyDispatcher(const void* result) {
+    FireboltSDK::Trace::Span span("lifecycle.ready", "dispatch");
     Firebolt::IFireboltAccessor::Instance().MetricsInterface().ready();
 }
 
 // localCallback to update the state
 static void onReadyInnerCallback(void* notification, const void* userData, void* jsonResponse )
 {
+    FireboltSDK::Trace::Span span("lifecycle.onStateChanged", "callback");
     const LifecycleImpl* selfConst = static_cast<const LifecycleImpl*>(userData);
     LifecycleImpl* self = const_cast<LifecycleImpl*>(selfConst);
 
@@ -49,63 +61,131 @@ static void onReadyInnerCallback(void* notification, const void* userData, void*
     ASSERT(proxyResponse.IsValid() == true);
 
     if (proxyResponse.IsValid() == true) {
-        LifecycleEvent value;
-
-        value.state = proxyResponse->State;
-        std::string stateStr = ConvertEnum<Firebolt::Lifecycle::LifecycleState>(lifecycleStateMap, value.state);
-        // Assign stateStr to currentState in ${info.Title}Impl instance
-        self->currentState = stateStr;
-        std::cout << "Updated the Current State to: " << self->currentState << std::endl;
+        FIREBOLT_PROBE_EVENT_RECEIVE("lifecycle.onStateChanged", *proxyResponse);
+        const LifecycleState state = proxyResponse->State;
+        FIREBOLT_PROBE_CALLBACK_START("lifecycle.onStateChanged");
+        self->updateState(state);
+        FIREBOLT_PROBE_CALLBACK_FINISH("lifecycle.onStateChanged");
+        FIREBOLT_LOG_INFO(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Updated the Current State to: %s", lifecycleStateName(state));
 
         proxyResponse.Release();
 
     }
 }
- 
+
+// Subscribes to all eventNames. Every Prioritize blocks until its reply arrives, so keeping
+// several in flight takes a thread each. Starting and joining those threads costs a few hundred
+// us, so they are only used when the round-trip of the first subscribe, times the events left,
+// exceeds that; otherwise the rest are subscribed in sequence on the calling thread.
+static constexpr uint64_t ParallelSubscribeUs = 250;
+
+template <typename RESPONSE, size_t N>
+static Firebolt::Error prioritizeAll(const char* const (&eventNames)[N], void (*callback)(void*, const void*, void*), const void* userdata)
+{
+    static_assert(N > 1, "a single event is subscribed with Prioritize");
+
+    auto subscribe = [callback, userdata](const char* eventName) {
+        FIREBOLT_MEMORY_SCOPE("event");
+        // Event adds the listen flag to the parameters, so each request gets its own
+        JsonObject jsonParameters;
+        return FireboltSDK::Event::Instance().Prioritize<RESPONSE>(eventName, jsonParameters, callback, (void*)nullptr, userdata);
+    };
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Firebolt::Error status = subscribe(eventNames[0]);
+    const uint64_t roundTrip = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if ((roundTrip * (N - 1)) < ParallelSubscribeUs) {
+        for (size_t index = 1; index < N; ++index) {
+            const Firebolt::Error subscribed = subscribe(eventNames[index]);
+            if (status == Firebolt::Error::None) {
+                status = subscribed;
+            }
+        }
+    } else {
+        std::vector<std::future<Firebolt::Error>> pending;
+        pending.reserve(N - 1);
+        for (size_t index = 2; index < N; ++index) {
+            pending.push_back(std::async(std::launch::async, subscribe, eventNames[index]));
+        }
+        // One of the remaining ones runs on the calling thread while the others are in flight
+        const Firebolt::Error second = subscribe(eventNames[1]);
+        if (status == Firebolt::Error::None) {
+            status = second;
+        }
+        for (auto& result : pending) {
+            const Firebolt::Error subscribed = result.get();
+            if (status == Firebolt::Error::None) {
+                status = subscribed;
+            }
+        }
+    }
+    return status;
+}
 
 
 /* ready - Notify the platform that the app is ready */
 void ${info.Title}Impl::ready(Firebolt::Error *err) {  
+    FIREBOLT_MEMORY_SCOPE("${info.title.lowercase}");
     Firebolt::Error status = Firebolt::Error::NotConnected;
 
-    JsonObject jsonParameters;
-
-    // Call Prioritize to subscribe to corresponding event, add to internalMap, and prioritize its callback
-    status = FireboltSDK::Event::Instance().Prioritize<JsonData_LifecycleEvent>("lifecycle.onForeground", jsonParameters, onReadyInnerCallback, (void*)nullptr, this);
-    status = FireboltSDK::Event::Instance().Prioritize<JsonData_LifecycleEvent>("lifecycle.onBackground", jsonParameters, onReadyInnerCallback, (void*)nullptr, this);
-    status = FireboltSDK::Event::Instance().Prioritize<JsonData_LifecycleEvent>("lifecycle.onInactive", jsonParameters, onReadyInnerCallback, (void*)nullptr, this);
-    status = FireboltSDK::Event::Instance().Prioritize<JsonData_LifecycleEvent>("lifecycle.onSuspended", jsonParameters, onReadyInnerCallback, (void*)nullptr, this);
-    status = FireboltSDK::Event::Instance().Prioritize<JsonData_LifecycleEvent>("lifecycle.onUnloading", jsonParameters, onReadyInnerCallback, (void*)nullptr, this);
-   
-    FireboltSDK::Transport<WPEFramework::Core::JSON::IElement>* transport = FireboltSDK::Accessor::Instance().GetTransport();
-    if (transport != nullptr) {
-        WPEFramework::Core::JSON::VariantContainer jsonResult;
-        status = transport->Invoke("lifecycle.ready", jsonParameters, jsonResult);
-        if (status == Firebolt::Error::None) {
-            FIREBOLT_LOG_INFO(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Lifecycle.ready is successfully invoked");
-
-            WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch> job = WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch>(WPEFramework::Core::ProxyType<FireboltSDK::Worker>::Create(readyDispatcher, nullptr));
-            WPEFramework::Core::IWorkerPool::Instance().Submit(job);
-        } else {
-            FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in invoking lifecycle.ready: %d", status);
-            if (err != nullptr) {
-                *err = status;
-            }
-        }
+    // Subscribe to all state change events, add them to internalMap, and prioritize their callbacks
+    static constexpr const char* lifecycleEvents[] = {
+        "lifecycle.onForeground",
+        "lifecycle.onBackground",
+        "lifecycle.onInactive",
+        "lifecycle.onSuspended",
+        "lifecycle.onUnloading"
+    };
+    status = prioritizeAll<JsonData_LifecycleEvent>(lifecycleEvents, onReadyInnerCallback, this);
+    if (status != Firebolt::Error::None) {
+        FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in subscribing to lifecycle events: %d", status);
+    }
 
-    } else {
-        FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in getting Transport err = %d", status);
-        if (err != nullptr) {
-            *err = status;
-        }
+    status = FireboltSDK::InvokeMethod<FireboltSDK::NoResult>(Ready, FireboltSDK::Discard());
+    if (status == Firebolt::Error::None) {
+        WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch> job = WPEFramework::Core::ProxyType<WPEFramework::Core::IDispatch>(WPEFramework::Core::ProxyType<FireboltSDK::Worker>::Create(readyDispatcher, nullptr));
+        WPEFramework::Core::IWorkerPool::Instance().Submit(job);
+    } else if (err != nullptr) {
+        *err = status;
     }
 }  
 
 
-/* state - return the state of the app */
-std::string ${info.Title}Impl::state(Firebolt::Error *err)  {
-    std::cout << "**CURRENT STATE OF THE APP::::**" << currentState << std::endl;
-    return currentState;
+/* waitForState - block until the app reaches the given state */
+bool ${info.Title}Impl::waitForState(const LifecycleState state, const uint32_t timeoutMs, Firebolt::Error *err) const
+{
+    Firebolt::Error status = Firebolt::Error::None;
+
+    if (StateOf(_state.load(std::memory_order_acquire)) != state) {
+        std::unique_lock<std::mutex> lock(_stateLock);
+        const bool reached = _stateChanged.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, state]() {
+            return (StateOf(_state.load(std::memory_order_acquire)) == state);
+        });
+        if (reached == false) {
+            status = Firebolt::Error::Timedout;
+        }
+    }
+    if (err != nullptr) {
+        *err = status;
+    }
+
+    return (status == Firebolt::Error::None);
+}
+
+/* updateState - publish a new state and wake up waitForState callers */
+void ${info.Title}Impl::updateState(const LifecycleState state)
+{
+    uint64_t current = _state.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = ((current >> StateBits) + 1) << StateBits | static_cast<uint64_t>(state);
+    } while (_state.compare_exchange_weak(current, next, std::memory_order_release, std::memory_order_relaxed) == false);
+
+    // Waiters test the state under _stateLock, taking it here closes the window
+    // between their check and their wait, so no wakeup can get lost.
+    { std::lock_guard<std::mutex> lock(_stateLock); }
+    _stateChanged.notify_all();
 }
 
 
@@ -113,24 +193,10 @@ std::string ${info.Title}Impl::state(Firebolt::Error *err)  {
 /* finished - Notify the platform that the app is done unloading */
 void ${info.Title}Impl::finished(Firebolt::Error *err) 
 {
-    Firebolt::Error status = Firebolt::Error::NotConnected;
-        if(currentState == "unloading")
+    FIREBOLT_MEMORY_SCOPE("${info.title.lowercase}");
+        if (state() == LifecycleState::UNLOADING)
         {
-            FireboltSDK::Transport<WPEFramework::Core::JSON::IElement>* transport = FireboltSDK::Accessor::Instance().GetTransport();
-            if (transport != nullptr) {
-            
-                JsonObject jsonParameters;
-        
-                WPEFramework::Core::JSON::VariantContainer jsonResult;
-                status = transport->Invoke("lifecycle.finished", jsonParameters, jsonResult);
-                if (status == Firebolt::Error::None) {
-                    FIREBOLT_LOG_INFO(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Lifecycle.finished is successfully invoked");
-        
-                }
-
-            } else {
-                FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in getting Transport err = %d", status);
-            }
+            FireboltSDK::InvokeMethod<FireboltSDK::NoResult>(Finished, FireboltSDK::Discard());
         }
 
     return;
@@ -17,10 +17,16 @@
 #pragma once
 
 #include "FireboltSDK.h"
+#include "Logger/AsyncLogger.h"
 #include "IModule.h"
+#include "Instrumentation/Latency.h"
+#include "Invoke.h"
 #include "firebolt.h"
 #include "jsondata_lifecycle.h"
 #include "${info.title.lowercase}.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 /* ${IMPORTS} */
 
@@ -34,7 +40,7 @@ ${if.enums}
 ${if.types}
 // Types
 /* ${TYPES:json-types} */${end.if.types}
-${if.methods}class ${info.Title}Impl : public I${info.Title}, public IModule {
+${if.methods}class ${info.Title}Impl final : public I${info.Title}, public IModule {
 
 public:
     ${info.Title}Impl() = default;
@@ -42,15 +48,39 @@ public:
     ${info.Title}Impl& operator=(const ${info.Title}Impl&) = delete;
     ~${info.Title}Impl() override = default;
 
-    std::string currentState = "INITIALIZING";
-
     // Methods & Events
     /* ${METHODS:declarations-override} */
 
     void finished(Firebolt::Error *err = nullptr) override ;
     void ready(Firebolt::Error *err = nullptr) override;
-    std::string state(Firebolt::Error *err = nullptr) override;
- 
+    // Inline, so calls on a LifecycleImpl& (see FireboltSDK::Direct) reduce to the atomic load
+    LifecycleState state(Firebolt::Error *err = nullptr) const override
+    {
+        if (err != nullptr) {
+            *err = Firebolt::Error::None;
+        }
+        return StateOf(_state.load(std::memory_order_acquire));
+    }
+    bool waitForState(const LifecycleState state, const uint32_t timeoutMs, Firebolt::Error *err = nullptr) const override;
+
+    // Called from the event dispatch thread on every lifecycle transition
+    void updateState(const LifecycleState state);
+
+private:
+    // Low byte holds the LifecycleState, the remaining bits a transition sequence number,
+    // so a state and the transition that produced it are always published together.
+    static constexpr uint32_t StateBits = 8;
+    static constexpr uint64_t StateMask = (1 << StateBits) - 1;
+
+    static LifecycleState StateOf(const uint64_t value)
+    {
+        return static_cast<LifecycleState>(value & StateMask);
+    }
+
+private:
+    std::atomic<uint64_t> _state { static_cast<uint64_t>(LifecycleState::INITIALIZING) };
+    mutable std::mutex _stateLock;
+    mutable std::condition_variable _stateChanged;
 };${end.if.methods}
 
 } // namespace ${info.Title}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "error.h"
+#include <cstdint>
+#include <optional>
+#include <string>
 /* ${IMPORTS} */
 
 ${if.declarations}namespace Firebolt {
@@ -13,12 +16,36 @@ ${if.types}
 // Types
 /* ${TYPES} */${end.if.types}
 ${if.providers}/* ${PROVIDERS} */${end.if.providers}${if.xuses}/* ${XUSES} */${end.if.xuses}
+// Category of an action() event: USER for actions the user initiated, APP for all others
+enum class ActionCategory {
+    USER,
+    APP
+};
+
 ${if.methods}struct I${info.Title} {
 
     virtual ~I${info.Title}() = default;
     virtual bool ready( Firebolt::Error *err = nullptr ) = 0 ;
     virtual bool signIn( Firebolt::Error *err = nullptr ) = 0 ;
     virtual bool signOut( Firebolt::Error *err = nullptr ) = 0 ;
+    virtual bool startContent( const std::optional<std::string>& entityId, Firebolt::Error *err = nullptr ) = 0 ;
+    virtual bool stopContent( const std::optional<std::string>& entityId, Firebolt::Error *err = nullptr ) = 0 ;
+    virtual bool page( const std::string& pageId, Firebolt::Error *err = nullptr ) = 0 ;
+    virtual bool action( const ActionCategory category, const std::string& type, const std::optional<Firebolt::Types::FlatMap>& parameters, Firebolt::Error *err = nullptr ) = 0 ;
+
+    // Asynchronous mode: the calls above return right away and the events are sent, back
+    // to back, from a background thread once batchSize are pending or every flushIntervalMs.
+    // Events still queued when the module is destroyed are dropped, call flush() or
+    // disableAsync() before disposing the accessor to deliver them.
+    virtual void enableAsync( const uint32_t batchSize, const uint32_t flushIntervalMs, Firebolt::Error *err = nullptr ) = 0 ;
+    virtual void disableAsync( Firebolt::Error *err = nullptr ) = 0 ;
+    // Sends all queued events before returning
+    virtual void flush( Firebolt::Error *err = nullptr ) = 0 ;
+
+    // Offline buffer: events raised while there is no connection are kept in a memory-mapped
+    // ring of capacity bytes at path, and replayed in order once the connection is back. A
+    // background thread retries the replay every second while there is such a backlog.
+    virtual void enableOfflineBuffer( const std::string& path, const uint32_t capacity, Firebolt::Error *err = nullptr ) = 0 ;
 
     // Methods & Events
     /* ${METHODS:declarations} */
@@ -17,6 +17,7 @@
  */
 
 #include "${info.title.lowercase}_impl.h"
+#include <algorithm>
 
 
 ${if.implementations}
@@ -25,85 +26,334 @@ namespace ${info.Title} {
 ${if.providers}
 /* ${PROVIDERS} */${end.if.providers}
 
-/* ready - Inform the platform that your app is minimally usable. This method is called automatically by `Lifecycle.ready()` */
-    bool ${info.Title}Impl::ready( Firebolt::Error *err )  
+    /* invoke - Invoke a metrics method, parameters are JSON object text or "", and report success */
+    bool ${info.Title}Impl::invoke( const char* method, const char* parameters, Firebolt::Error& status )
     {
-        Firebolt::Error status = Firebolt::Error::NotConnected;
+        JsonObject jsonParameters;
+        if ((parameters[0] != '\0') && (jsonParameters.FromString(parameters) == false)) {
+            FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Invalid parameters for %s: %s", method, parameters);
+            status = Firebolt::Error::General;
+            return false;
+        }
         bool success = false;
-        FireboltSDK::Transport<WPEFramework::Core::JSON::IElement>* transport = FireboltSDK::Accessor::Instance().GetTransport();
-        if (transport != nullptr) {
-        
-            JsonObject jsonParameters;
-    
-            WPEFramework::Core::JSON::Boolean jsonResult;
-            status = transport->Invoke("${info.title.lowercase}.ready", jsonParameters, jsonResult);
-            if (status == Firebolt::Error::None) {
-                FIREBOLT_LOG_INFO(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Metrics.ready is successfully invoked");
-                success = jsonResult.Value();
-            }
+        status = FireboltSDK::InvokeMethod<WPEFramework::Core::JSON::Boolean>(method, [&success](const WPEFramework::Core::JSON::Boolean& jsonResult) {
+            success = jsonResult.Value();
+        }, jsonParameters);
+        return success;
+    }
 
-        } else {
-            FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in getting Transport err = %d", status);
+    /* post - Queue the event in asynchronous mode, send it otherwise */
+    bool ${info.Title}Impl::post( const char* method, EventParameters& parameters, Firebolt::Error *err )
+    {
+        if (enqueue(method, parameters, err) == true) {
+            return true;
         }
+        Firebolt::Error status;
+        bool success = send(method, parameters.Text(), status);
         if (err != nullptr) {
             *err = status;
         }
+        return success;
+    }
 
+    /* send - Invoke the method, or keep it in the offline buffer while there is no connection */
+    bool ${info.Title}Impl::send( const char* method, const char* parameters, Firebolt::Error& status )
+    {
+        FIREBOLT_MEMORY_SCOPE("${info.title.lowercase}");
+        bool success = false;
+        if (_backlog.load(std::memory_order_acquire) == false) {
+            success = invoke(method, parameters, status);
+        } else {
+            // Queue up behind the backlog to keep the order, the replayer thread sends it
+            status = Firebolt::Error::NotConnected;
+        }
+        if (status == Firebolt::Error::NotConnected) {
+            std::lock_guard<std::mutex> lock(_journalLock);
+            if ((_journal.IsOpen() == true) && (_journal.Append(method, parameters) == true)) {
+                if (_backlog.exchange(true, std::memory_order_release) == false) {
+                    _reconnect.notify_one();
+                }
+                status = Firebolt::Error::None;
+                success = true;
+            }
+        }
         return success;
     }
 
+    /* replay - Send the events kept while offline, oldest first, until the connection drops again. Replayer thread only */
+    void ${info.Title}Impl::replay()
+    {
+        std::string method;
+        std::string parameters;
+        uint64_t position;
+        uint32_t replayed = 0;
+        std::unique_lock<std::mutex> lock(_journalLock);
+        while (_journal.Peek(method, parameters, position) == true) {
+            lock.unlock();
+            Firebolt::Error status;
+            invoke(method.c_str(), parameters.c_str(), status);
+            lock.lock();
+            if (status == Firebolt::Error::NotConnected) {
+                break;
+            }
+            // Any other failure would fail on every replay too, so it is not retried
+            _journal.Drop(position);
+            ++replayed;
+        }
+        _backlog.store(_journal.IsEmpty() == false, std::memory_order_release);
+        lock.unlock();
 
-  /* signIn - Log a sign In event, called by Discovery.signIn(). */
-    bool ${info.Title}Impl::signIn( Firebolt::Error *err )  
+        if (replayed > 0) {
+            FIREBOLT_PROBE_RECONNECT(replayed);
+        }
+    }
+
+    /* replayer - Background thread, retries the replay while there is a backlog until the connection is back */
+    void ${info.Title}Impl::replayer()
     {
-        Firebolt::Error status = Firebolt::Error::NotConnected;
-        bool success = false;
-        FireboltSDK::Transport<WPEFramework::Core::JSON::IElement>* transport = FireboltSDK::Accessor::Instance().GetTransport();
-        if (transport != nullptr) {
-        
-            JsonObject jsonParameters;
-    
-            WPEFramework::Core::JSON::Boolean jsonResult;
-            status = transport->Invoke("${info.title.lowercase}.signIn", jsonParameters, jsonResult);
-            if (status == Firebolt::Error::None) {
-                FIREBOLT_LOG_INFO(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Metrics.signOut is successfully invoked");
-                success = jsonResult.Value();
+        std::unique_lock<std::mutex> lock(_journalLock);
+        while (_closing == false) {
+            if (_journal.IsEmpty() == true) {
+                _reconnect.wait(lock);
+            } else {
+                _reconnect.wait_for(lock, std::chrono::milliseconds(ReplayIntervalMs));
+            }
+            if ((_closing == false) && (_journal.IsEmpty() == false)) {
+                lock.unlock();
+                replay();
+                lock.lock();
             }
+        }
+    }
 
-        } else {
-            FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in getting Transport err = %d", status);
+    /* close - Stop the replayer thread, leaving the journal in place for the next run */
+    void ${info.Title}Impl::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_journalLock);
+            _closing = true;
+        }
+        _reconnect.notify_one();
+        if (_replayer.joinable() == true) {
+            _replayer.join();
+        }
+    }
+
+    /* enqueue - Queue the event for the flusher thread, if asynchronous mode is on */
+    bool ${info.Title}Impl::enqueue( const char* method, EventParameters& parameters, Firebolt::Error *err )
+    {
+        // Text() closes the object, which may move it to the heap
+        const char* text = parameters.Text();
+        if (parameters.IsInline() == false) {
+            return false;
+        }
+
+        // Counted before _async is checked, so quiesce() can wait for this push to finish
+        _producers.fetch_add(1);
+        const bool queued = _async.load();
+        if (queued == true) {
+            if (_queue->Push(method, text, parameters.Length()) == true) {
+                if (_pending.fetch_add(1, std::memory_order_relaxed) + 1 == _batchSize.load(std::memory_order_relaxed)) {
+                    // Flusher also wakes up every flush interval, a notify missed here only delays this batch
+                    _wakeup.notify_one();
+                }
+            } else {
+                FIREBOLT_LOG_WARNING(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Metrics queue is full, dropping %s", method);
+            }
+        }
+        _producers.fetch_sub(1, std::memory_order_release);
+
+        if ((queued == true) && (err != nullptr)) {
+            *err = Firebolt::Error::None;
+        }
+        return queued;
+    }
+
+    /* quiesce - Turn asynchronous mode off and wait for the pushes already under way */
+    void ${info.Title}Impl::quiesce()
+    {
+        _async.store(false);
+        while (_producers.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    /* stop - Stop the flusher thread, leaving what is queued in place */
+    void ${info.Title}Impl::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_adminLock);
+            _stopping = true;
+        }
+        _wakeup.notify_one();
+        if (_flusher.joinable() == true) {
+            _flusher.join();
+        }
+    }
+
+    /* drain - Send everything queued so far, in order */
+    void ${info.Title}Impl::drain()
+    {
+        std::lock_guard<std::mutex> lock(_flushLock);
+        if (_queue == nullptr) {
+            return;
         }
+        EventRing::Event event;
+        while (_queue->Pop(event) == true) {
+            _pending.fetch_sub(1, std::memory_order_relaxed);
+            Firebolt::Error status;
+            send(event.method, event.parameters, status);
+            if (status != Firebolt::Error::None) {
+                FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in sending queued %s: %d", event.method, status);
+            }
+        }
+    }
+
+    /* flusher - Background thread, flushes on batch size or flush interval */
+    void ${info.Title}Impl::flusher()
+    {
+        FIREBOLT_MEMORY_SCOPE("${info.title.lowercase}");
+        std::unique_lock<std::mutex> lock(_adminLock);
+        while (true) {
+            _wakeup.wait_for(lock, std::chrono::milliseconds(_flushIntervalMs.load(std::memory_order_relaxed)), [this]() {
+                return ((_stopping == true) || (_pending.load(std::memory_order_relaxed) >= _batchSize.load(std::memory_order_relaxed)));
+            });
+            if (_stopping == true) {
+                break;
+            }
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+    void ${info.Title}Impl::enableAsync( const uint32_t batchSize, const uint32_t flushIntervalMs, Firebolt::Error *err )
+    {
+        FIREBOLT_MEMORY_SCOPE("${info.title.lowercase}");
+        std::lock_guard<std::mutex> lock(_adminLock);
+        _batchSize.store(std::max(batchSize, 1u), std::memory_order_relaxed);
+        _flushIntervalMs.store(std::max(flushIntervalMs, 1u), std::memory_order_relaxed);
+
+        const uint32_t size = std::max(MinimumQueueSize, batchSize * 4);
+        if ((_queue == nullptr) || (_queue->Capacity() < size)) {
+            // Events raised while the ring is swapped are sent right away
+            quiesce();
+            std::lock_guard<std::mutex> flushLock(_flushLock);
+            std::unique_ptr<EventRing> queue(new EventRing(size));
+            if (_queue != nullptr) {
+                EventRing::Event event;
+                while (_queue->Pop(event) == true) {
+                    queue->Push(event.method, event.parameters, event.length);
+                }
+            }
+            _queue = std::move(queue);
+        }
+        if (_flusher.joinable() == false) {
+            _stopping = false;
+            _flusher = std::thread(&${info.Title}Impl::flusher, this);
+        }
+        _async.store(true);
+
+        if (err != nullptr) {
+            *err = Firebolt::Error::None;
+        }
+    }
+
+    void ${info.Title}Impl::disableAsync( Firebolt::Error *err )
+    {
+        quiesce();
+        stop();
+        flush(err);
+    }
+
+    void ${info.Title}Impl::flush( Firebolt::Error *err )
+    {
+        drain();
+        if (err != nullptr) {
+            *err = Firebolt::Error::None;
+        }
+    }
+
+    void ${info.Title}Impl::enableOfflineBuffer( const std::string& path, const uint32_t capacity, Firebolt::Error *err )
+    {
+        FIREBOLT_MEMORY_SCOPE("${info.title.lowercase}");
+        std::lock_guard<std::mutex> lock(_journalLock);
+        Firebolt::Error status = _journal.Open(path, capacity);
+        if (status != Firebolt::Error::None) {
+            FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in opening metrics offline buffer %s", path.c_str());
+        }
+        // Events left over from a previous run get replayed once there is a connection
+        _backlog.store(_journal.IsEmpty() == false, std::memory_order_release);
+        if ((_journal.IsOpen() == true) && (_replayer.joinable() == false)) {
+            _closing = false;
+            _replayer = std::thread(&${info.Title}Impl::replayer, this);
+        }
+
         if (err != nullptr) {
             *err = status;
         }
-        return success;
+    }
+
+    /* ready - Inform the platform that your app is minimally usable. This method is called automatically by `Lifecycle.ready()` */
+    bool ${info.Title}Impl::ready( Firebolt::Error *err )  
+    {
+        EventParameters parameters;
+        return post("${info.title.lowercase}.ready", parameters, err);
+    }
+
+
+  /* signIn - Log a sign In event, called by Discovery.signIn(). */
+    bool ${info.Title}Impl::signIn( Firebolt::Error *err )  
+    {
+        EventParameters parameters;
+        return post("${info.title.lowercase}.signIn", parameters, err);
 
     }  
     /* signOut - Log a sign out event, called by Discovery.signOut(). */
     bool ${info.Title}Impl::signOut( Firebolt::Error *err )  
     {
-        Firebolt::Error status = Firebolt::Error::NotConnected;
-        bool success = false;
-        FireboltSDK::Transport<WPEFramework::Core::JSON::IElement>* transport = FireboltSDK::Accessor::Instance().GetTransport();
-        if (transport != nullptr) {
-        
-            JsonObject jsonParameters;
-    
-            WPEFramework::Core::JSON::Boolean jsonResult;
-            status = transport->Invoke("${info.title.lowercase}.signOut", jsonParameters, jsonResult);
-            if (status == Firebolt::Error::None) {
-                FIREBOLT_LOG_INFO(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Metrics.signOut is successfully invoked");
-                success = jsonResult.Value();
-            }
+        EventParameters parameters;
+        return post("${info.title.lowercase}.signOut", parameters, err);
+    }
 
-        } else {
-            FIREBOLT_LOG_ERROR(FireboltSDK::Logger::Category::OpenRPC, FireboltSDK::Logger::Module<FireboltSDK::Accessor>(), "Error in getting Transport err = %d", status);
+    /* startContent - Inform the platform that your user has started content. */
+    bool ${info.Title}Impl::startContent( const std::optional<std::string>& entityId, Firebolt::Error *err )
+    {
+        EventParameters parameters;
+        if (entityId.has_value() == true) {
+            parameters.Add("entityId", entityId.value());
         }
-        if (err != nullptr) {
-            *err = status;
+        return post("${info.title.lowercase}.startContent", parameters, err);
+    }
+
+    /* stopContent - Inform the platform that your user has stopped content. */
+    bool ${info.Title}Impl::stopContent( const std::optional<std::string>& entityId, Firebolt::Error *err )
+    {
+        EventParameters parameters;
+        if (entityId.has_value() == true) {
+            parameters.Add("entityId", entityId.value());
         }
+        return post("${info.title.lowercase}.stopContent", parameters, err);
+    }
 
-        return success;
+    /* page - Inform the platform that your user has navigated to a page or view. */
+    bool ${info.Title}Impl::page( const std::string& pageId, Firebolt::Error *err )
+    {
+        EventParameters parameters;
+        parameters.Add("pageId", pageId);
+        return post("${info.title.lowercase}.page", parameters, err);
+    }
+
+    /* action - Inform the platform of something not covered by other Metrics APIs. */
+    bool ${info.Title}Impl::action( const ActionCategory category, const std::string& type, const std::optional<Firebolt::Types::FlatMap>& parameters, Firebolt::Error *err )
+    {
+        EventParameters eventParameters;
+        eventParameters.Add("category", (category == ActionCategory::USER) ? "user" : "app");
+        eventParameters.Add("type", type);
+        if (parameters.has_value() == true) {
+            eventParameters.Add("parameters", parameters.value());
+        }
+        return post("${info.title.lowercase}.action", eventParameters, err);
     }
 
 
@@ -19,7 +19,21 @@
 #pragma once
 
 #include "FireboltSDK.h"
+#include "Logger/AsyncLogger.h"
 #include "IModule.h"
+#include "Instrumentation/Latency.h"
+#include "Invoke.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 /* ${IMPORTS} */
 #include "${info.title.lowercase}.h"
@@ -33,24 +47,474 @@ ${if.enums}
 ${if.types}
     // Types
 /* ${TYPES:json-types} */${end.if.types}
-    ${if.methods}class ${info.Title}Impl : public I${info.Title}, public IModule {
+    // Bounded multi-producer/single-consumer ring of pending metrics events. Each slot holds the
+    // method and its parameters as JSON text, up to MaxParameters bytes. Push never blocks or
+    // allocates: when the ring is full, or the parameters do not fit a slot, the event is dropped.
+    class EventRing {
+    public:
+        static constexpr uint16_t MaxParameters = 232;
+
+        struct Event {
+            const char* method;
+            uint16_t length;
+            char parameters[MaxParameters + 1];
+        };
+
+        EventRing() = delete;
+        EventRing(const EventRing&) = delete;
+        EventRing& operator=(const EventRing&) = delete;
+
+        explicit EventRing(const uint32_t capacity)
+            : _mask(RoundUp(capacity) - 1)
+            , _slots(new Slot[_mask + 1])
+            , _head(0)
+            , _tail(0)
+        {
+            for (uint32_t index = 0; index <= _mask; ++index) {
+                _slots[index].sequence.store(index, std::memory_order_relaxed);
+            }
+        }
+        ~EventRing() = default;
+
+        uint32_t Capacity() const
+        {
+            return (_mask + 1);
+        }
+
+        bool Push(const char* method, const char* parameters, const uint16_t length)
+        {
+            if (length > MaxParameters) {
+                return false;
+            }
+            uint32_t position = _tail.load(std::memory_order_relaxed);
+            while (true) {
+                Slot& slot = _slots[position & _mask];
+                const int32_t distance = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - position);
+                if (distance == 0) {
+                    if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                        slot.method = method;
+                        slot.length = length;
+                        memcpy(slot.parameters, parameters, length);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (distance < 0) {
+                    return false;
+                } else {
+                    position = _tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Single consumer only
+        bool Pop(Event& event)
+        {
+            const uint32_t position = _head.load(std::memory_order_relaxed);
+            Slot& slot = _slots[position & _mask];
+            if (static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - (position + 1)) < 0) {
+                return false;
+            }
+            event.method = slot.method;
+            event.length = slot.length;
+            memcpy(event.parameters, slot.parameters, slot.length);
+            event.parameters[slot.length] = '\0';
+            slot.sequence.store(position + _mask + 1, std::memory_order_release);
+            _head.store(position + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+    private:
+        static uint32_t RoundUp(const uint32_t value)
+        {
+            uint32_t result = 2;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        struct Slot {
+            std::atomic<uint32_t> sequence;
+            uint16_t length;
+            const char* method;
+            char parameters[MaxParameters + 1];
+        };
+
+        const uint32_t _mask;
+        std::unique_ptr<Slot[]> _slots;
+        alignas(64) std::atomic<uint32_t> _head;
+        alignas(64) std::atomic<uint32_t> _tail;
+    };
+
+    // JSON object text of the parameters of an event, built in place. Only when it outgrows a
+    // queue slot it moves to the heap, such an event is sent right away instead of queued.
+    class EventParameters {
+    public:
+        EventParameters(const EventParameters&) = delete;
+        EventParameters& operator=(const EventParameters&) = delete;
+
+        EventParameters()
+            : _length(0)
+            , _closed(false)
+        {
+        }
+        ~EventParameters() = default;
+
+        void Add(const char* name, const std::string& value)
+        {
+            Name(name);
+            String(value);
+        }
+        void Add(const char* name, const Firebolt::Types::FlatMap& values)
+        {
+            Name(name);
+            Append("{", 1);
+            bool first = true;
+            for (const auto& value : values) {
+                if (first == false) {
+                    Append(",", 1);
+                }
+                first = false;
+                String(value.first);
+                Append(":", 1);
+                String(value.second);
+            }
+            Append("}", 1);
+        }
+
+        // "" without parameters
+        const char* Text()
+        {
+            if ((_length > 0) && (_closed == false)) {
+                Append("}", 1);
+                _closed = true;
+            }
+            if (_spill.empty() == false) {
+                return _spill.c_str();
+            }
+            _inline[_length] = '\0';
+            return _inline;
+        }
+        uint16_t Length() const
+        {
+            return static_cast<uint16_t>(_length);
+        }
+        bool IsInline() const
+        {
+            return _spill.empty();
+        }
+
+    private:
+        void Name(const char* name)
+        {
+            Append((_length == 0) ? "{\"" : ",\"", 2);
+            Append(name, strlen(name));
+            Append("\":", 2);
+        }
+        // Quoted and escaped
+        void String(const std::string& value)
+        {
+            Append("\"", 1);
+            for (const char character : value) {
+                if ((character == '"') || (character == '\\')) {
+                    const char escaped[] = { '\\', character };
+                    Append(escaped, sizeof(escaped));
+                } else if (static_cast<unsigned char>(character) < 0x20) {
+                    char escaped[7];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(character));
+                    Append(escaped, 6);
+                } else {
+                    Append(&character, 1);
+                }
+            }
+            Append("\"", 1);
+        }
+        void Append(const char* data, const size_t length)
+        {
+            if ((_spill.empty() == true) && (_length + length <= EventRing::MaxParameters)) {
+                memcpy(_inline + _length, data, length);
+            } else {
+                if (_spill.empty() == true) {
+                    _spill.assign(_inline, _length);
+                }
+                _spill.append(data, length);
+            }
+            _length += length;
+        }
+
+    private:
+        size_t _length;
+        bool _closed;
+        char _inline[EventRing::MaxParameters + 1];
+        std::string _spill;
+    };
+
+    // Bounded on-disk ring of events raised while disconnected, backed by a memory-mapped
+    // file so that appending is a plain memcpy and the backlog survives an app restart.
+    // When full, the oldest events are dropped. Not thread safe, callers serialize access.
+    class EventJournal {
+    private:
+        static constexpr uint32_t Magic = 0x4642454A; // FBEJ
+        static constexpr uint16_t Wrap = 0xFFFF;
+
+        struct Header {
+            uint32_t magic;
+            uint32_t capacity;
+            // Monotonic byte positions, taken modulo capacity to index the data area
+            uint64_t head;
+            uint64_t tail;
+        };
+
+    public:
+        EventJournal(const EventJournal&) = delete;
+        EventJournal& operator=(const EventJournal&) = delete;
+
+        EventJournal()
+            : _header(nullptr)
+            , _data(nullptr)
+            , _capacity(0)
+        {
+        }
+        ~EventJournal()
+        {
+            Close();
+        }
+
+        Firebolt::Error Open(const std::string& path, const uint32_t capacity)
+        {
+            Close();
+
+            const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+            if (fd < 0) {
+                return Firebolt::Error::General;
+            }
+            const size_t size = sizeof(Header) + capacity;
+            void* mapped = MAP_FAILED;
+            if (::ftruncate(fd, size) == 0) {
+                mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            ::close(fd);
+            if (mapped == MAP_FAILED) {
+                return Firebolt::Error::General;
+            }
+
+            _header = static_cast<Header*>(mapped);
+            _data = static_cast<uint8_t*>(mapped) + sizeof(Header);
+            _capacity = capacity;
+            // Keep a backlog left by a previous run, as long as its layout matches and each of
+            // its records does
+            if ((_header->magic != Magic) || (_header->capacity != capacity) || (_header->tail - _header->head > capacity)) {
+                _header->magic = Magic;
+                _header->capacity = capacity;
+                _header->head = 0;
+                _header->tail = 0;
+            }
+            uint64_t position = _header->head;
+            uint16_t length;
+            while ((position != _header->tail) && (Locate(position, length) == true)) {
+                position += sizeof(length) + length;
+            }
+            if (position != _header->tail) {
+                _header->head = _header->tail;
+            }
+            return Firebolt::Error::None;
+        }
+
+        void Close()
+        {
+            if (_header != nullptr) {
+                ::munmap(_header, sizeof(Header) + _capacity);
+                _header = nullptr;
+                _data = nullptr;
+                _capacity = 0;
+            }
+        }
+
+        bool IsOpen() const
+        {
+            return (_header != nullptr);
+        }
+        bool IsEmpty() const
+        {
+            return ((_header == nullptr) || (_header->head == _header->tail));
+        }
+
+        // Record is the method, a '\0' and the JSON text of the parameters
+        bool Append(const char* method, const char* parameters)
+        {
+            const size_t methodLength = strlen(method);
+            const size_t parametersLength = strlen(parameters);
+            const uint32_t needed = sizeof(uint16_t) + methodLength + 1 + parametersLength;
+            if ((_header == nullptr) || (needed >= Wrap) || (needed > _capacity / 2)) {
+                return false;
+            }
+            const uint16_t length = static_cast<uint16_t>(needed - sizeof(uint16_t));
+
+            // Records never straddle the end of the data area, pad up to it instead
+            const uint32_t offset = _header->tail % _capacity;
+            const uint32_t padding = (_capacity - offset < needed) ? (_capacity - offset) : 0;
+            while (_capacity - (_header->tail - _header->head) < padding + needed) {
+                DropOldest();
+            }
+            if (padding != 0) {
+                if (padding >= sizeof(Wrap)) {
+                    memcpy(_data + offset, &Wrap, sizeof(Wrap));
+                }
+                _header->tail += padding;
+            }
+            uint8_t* record = _data + (_header->tail % _capacity);
+            memcpy(record, &length, sizeof(length));
+            memcpy(record + sizeof(length), method, methodLength + 1);
+            memcpy(record + sizeof(length) + methodLength + 1, parameters, parametersLength);
+            _header->tail += needed;
+            return true;
+        }
+
+        // Oldest event and its position, left in place until Drop(position)
+        bool Peek(std::string& method, std::string& parameters, uint64_t& position)
+        {
+            uint16_t length;
+            if ((IsEmpty() == true) || (Head(length) == false)) {
+                return false;
+            }
+            position = _header->head;
+            const char* event = reinterpret_cast<const char*>(_data + (position % _capacity) + sizeof(length));
+            const size_t methodLength = strnlen(event, length);
+            method.assign(event, methodLength);
+            parameters.assign(event + std::min<size_t>(methodLength + 1, length), event + length);
+            return true;
+        }
+
+        // Drops the event Peek() returned, unless Append() made room by dropping it already
+        void Drop(const uint64_t position)
+        {
+            uint16_t length;
+            if ((IsEmpty() == false) && (Head(length) == true) && (_header->head == position)) {
+                _header->head += sizeof(length) + length;
+            }
+        }
+
+    private:
+        void DropOldest()
+        {
+            uint16_t length;
+            if ((IsEmpty() == false) && (Head(length) == true)) {
+                _header->head += sizeof(length) + length;
+            }
+        }
+
+        // Moves head past padding to the oldest record and returns its length. A record that
+        // Append() cannot have written, e.g. after a torn write, resets the journal to empty.
+        bool Head(uint16_t& length)
+        {
+            uint64_t position = _header->head;
+            if (Locate(position, length) == false) {
+                _header->head = _header->tail;
+                return false;
+            }
+            _header->head = position;
+            return true;
+        }
+
+        // Checks the record at position, after skipping padding up to the end of the data area,
+        // against the capacity and the bytes in use up to tail
+        bool Locate(uint64_t& position, uint16_t& length) const
+        {
+            uint32_t offset = position % _capacity;
+            uint16_t value = Wrap;
+            if (_capacity - offset >= sizeof(value)) {
+                memcpy(&value, _data + offset, sizeof(value));
+            }
+            if ((value == Wrap) || (_capacity - offset < sizeof(value) + value)) {
+                // Append() pads only to place a record right after it
+                if (_header->tail - position <= _capacity - offset) {
+                    return false;
+                }
+                position += _capacity - offset;
+                offset = 0;
+                memcpy(&value, _data, sizeof(value));
+            }
+            length = value;
+            return ((value != Wrap) && (sizeof(value) + value <= _header->tail - position) && (sizeof(value) + value <= _capacity - offset));
+        }
+
+    private:
+        Header* _header;
+        uint8_t* _data;
+        uint32_t _capacity;
+    };
+
+    ${if.methods}class ${info.Title}Impl final : public I${info.Title}, public IModule {
 
     public:
         ${info.Title}Impl() = default;
         ${info.Title}Impl(const ${info.Title}Impl&) = delete;
         ${info.Title}Impl& operator=(const ${info.Title}Impl&) = delete;
 
-        ~${info.Title}Impl() override = default;
+        ~${info.Title}Impl() override
+        {
+            // Only stops the threads: the transport may be gone already when this runs at exit
+            stop();
+            close();
+        }
 
    
-         bool ready( Firebolt::Error *err = nullptr )   ;
-         bool signIn( Firebolt::Error *err = nullptr )  ;
-         bool signOut( Firebolt::Error *err = nullptr ) ;
+         bool ready( Firebolt::Error *err = nullptr ) override;
+         bool signIn( Firebolt::Error *err = nullptr ) override;
+         bool signOut( Firebolt::Error *err = nullptr ) override;
+         bool startContent( const std::optional<std::string>& entityId, Firebolt::Error *err = nullptr ) override;
+         bool stopContent( const std::optional<std::string>& entityId, Firebolt::Error *err = nullptr ) override;
+         bool page( const std::string& pageId, Firebolt::Error *err = nullptr ) override;
+         bool action( const ActionCategory category, const std::string& type, const std::optional<Firebolt::Types::FlatMap>& parameters, Firebolt::Error *err = nullptr ) override;
+
+         void enableAsync( const uint32_t batchSize, const uint32_t flushIntervalMs, Firebolt::Error *err = nullptr ) override;
+         void disableAsync( Firebolt::Error *err = nullptr ) override;
+         void flush( Firebolt::Error *err = nullptr ) override;
+         void enableOfflineBuffer( const std::string& path, const uint32_t capacity, Firebolt::Error *err = nullptr ) override;
     
 
 
         // Methods & Events
         /* ${METHODS:declarations-override} */
+
+    private:
+        static bool invoke( const char* method, const char* parameters, Firebolt::Error& status );
+        bool post( const char* method, EventParameters& parameters, Firebolt::Error *err );
+        bool send( const char* method, const char* parameters, Firebolt::Error& status );
+        void replay();
+        void replayer();
+        void close();
+        bool enqueue( const char* method, EventParameters& parameters, Firebolt::Error *err );
+        void quiesce();
+        void stop();
+        void drain();
+        void flusher();
+
+    private:
+        static constexpr uint32_t MinimumQueueSize = 256;
+        static constexpr uint32_t ReplayIntervalMs = 1000;
+
+        // _queue is only replaced with no producer in enqueue(), see quiesce(), and under _flushLock
+        std::unique_ptr<EventRing> _queue;
+        std::atomic<bool> _async { false };
+        std::atomic<uint32_t> _producers { 0 };
+        std::atomic<uint32_t> _pending { 0 };
+        std::atomic<uint32_t> _batchSize { 0 };
+        std::atomic<uint32_t> _flushIntervalMs { 0 };
+
+        std::mutex _adminLock;
+        std::mutex _flushLock;
+        std::condition_variable _wakeup;
+        std::thread _flusher;
+        bool _stopping = false;
+
+        std::mutex _journalLock;
+        EventJournal _journal;
+        // Lets send() skip _journalLock while nothing is waiting to be replayed
+        std::atomic<bool> _backlog { false };
+        std::condition_variable _reconnect;
+        std::thread _replayer;
+        bool _closing = false;
     };${end.if.methods}
 
 }//namespace ${info.Title}
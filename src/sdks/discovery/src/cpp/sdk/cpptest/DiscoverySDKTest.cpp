@@ -69,24 +69,35 @@ bool DiscoverySDKTest::WaitOnConnectionReady()
     return _connected;
 }
 
-template<typename T>
-using EnumMap = std::unordered_map<T, string>;
+// Constant initialized, so the name tables allocate nothing before main
 template <typename T>
-inline const string& ConvertFromEnum(EnumMap<T> enumMap, T type)
+struct EnumName {
+    T value;
+    const char* name;
+};
+template <typename T, size_t N>
+using EnumMap = EnumName<T>[N];
+template <typename T, size_t N>
+inline const char* ConvertFromEnum(const EnumMap<T, N>& enumMap, T type)
 {
-    return enumMap[type];
+    for (const EnumName<T>& element : enumMap) {
+        if (element.value == type) {
+            return element.name;
+        }
+    }
+    return "";
 }
-template <typename T>
-inline const T ConvertToEnum(EnumMap<T> enumMap, const string& str)
+template <typename T, size_t N>
+inline T ConvertToEnum(const EnumMap<T, N>& enumMap, const string& str)
 {
-     T value;
-     for (auto element: enumMap) {
-          if (element.second == str) {
-              value = element.first;
-              break;
-          }
-     }
-     return value;
+    T value {};
+    for (const EnumName<T>& element : enumMap) {
+        if (str == element.name) {
+            value = element.value;
+            break;
+        }
+    }
+    return value;
 }
 
 void DiscoverySDKTest::SampleTest()
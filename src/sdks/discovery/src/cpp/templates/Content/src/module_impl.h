@@ -19,7 +19,10 @@
 #pragma once
 
 #include "FireboltSDK.h"
+#include "Logger/AsyncLogger.h"
 #include "IModule.h"
+#include "Instrumentation/Latency.h"
+#include "Invoke.h"
 /* ${IMPORTS} */
 #include "${info.title.lowercase}.h"
 
@@ -109,7 +112,7 @@ namespace ${info.Title} {
         Firebolt::Entity::JsonData_EntityDetails Entity;
     };
 
-    class ContentImpl : public IContent, public IModule {
+    class ContentImpl final : public IContent, public IModule {
 
     public:
         ContentImpl() = default;
@@ -81,27 +81,38 @@ bool ManageSDKTest::WaitOnConnectionReady()
     return _connected;
 }
 
-template<typename T>
-using EnumMap = std::unordered_map<T, string>;
+// Constant initialized, so the name tables allocate nothing before main
 template <typename T>
-inline const string& ConvertFromEnum(EnumMap<T> enumMap, T type)
-{
-    return enumMap[type];
+struct EnumName {
+    T value;
+    const char* name;
+};
+template <typename T, size_t N>
+using EnumMap = EnumName<T>[N];
+template <typename T, size_t N>
+inline const char* ConvertFromEnum(const EnumMap<T, N>& enumMap, T type)
+{
+    for (const EnumName<T>& element : enumMap) {
+        if (element.value == type) {
+            return element.name;
+        }
+    }
+    return "";
 }
-template <typename T>
-inline const T ConvertToEnum(EnumMap<T> enumMap, const string& str)
+template <typename T, size_t N>
+inline T ConvertToEnum(const EnumMap<T, N>& enumMap, const string& str)
 {
-     T value;
-     for (auto element: enumMap) {
-          if (element.second == str) {
-              value = element.first;
-              break;
-          }
-     }
-     return value;
+    T value {};
+    for (const EnumName<T>& element : enumMap) {
+        if (str == element.name) {
+            value = element.value;
+            break;
+        }
+    }
+    return value;
 }
 
-EnumMap<Firebolt::Advertising::SkipRestriction> skipRestrictionMap = {
+constexpr EnumName<Firebolt::Advertising::SkipRestriction> skipRestrictionMap[] = {
     { Firebolt::Advertising::SkipRestriction::NONE, "none" },
     { Firebolt::Advertising::SkipRestriction::ADS_UNWATCHED, "adsUnwatched" },
     { Firebolt::Advertising::SkipRestriction::ADS_ALL, "adsAll" },
@@ -123,8 +134,8 @@ void ManageSDKTest::SetAdvertisingSkipRestriction()
 {
     Firebolt::Error error = Firebolt::Error::None;
     cout << "Support SkipRestriction -> " << endl;
-    for (auto skipRestriction : skipRestrictionMap) {
-         cout << skipRestriction.second << endl;
+    for (const auto& skipRestriction : skipRestrictionMap) {
+         cout << skipRestriction.name << endl;
     }
     
     std::string skipRestriction = "none";
@@ -331,7 +342,7 @@ void ManageSDKTest::UnsubscribeClosedCaptionsBackgroundOpacityChanged()
     }
 }
 
-EnumMap<Firebolt::Accessibility::FontFamily> fontFamilyMap = {
+constexpr EnumName<Firebolt::Accessibility::FontFamily> fontFamilyMap[] = {
     { Firebolt::Accessibility::FontFamily::MONOSPACED_SERIF, "MonospacedSerif" },
     { Firebolt::Accessibility::FontFamily::PROPORTIONAL_SERIF, "ProportionalSerif" },
     { Firebolt::Accessibility::FontFamily::MONOSPACED_SANSERIF, "MonospacedSanserif" },